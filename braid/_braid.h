@@ -100,9 +100,94 @@ void _braid_ErrorHandler(const char *filename, braid_Int line, braid_Int ierr, c
 /* Used to implement periodic feature */
 #define _braid_SendIndexNull -2
 #define _braid_RecvIndexNull -2
+
 #define _braid_MapPeriodic(index, npoints) \
 ( index = ((index)+(npoints)) % (npoints) )  /* this also handles negative indexes */
 
+/** 
+ * Maximum number of vectors in one aggregated message, and the size of the
+ * message header holding the vector count (one braid_Real, to keep the vector
+ * slots aligned)
+ **/
+#define _braid_CommAggMax    2
+#define _braid_CommAggHeader sizeof(braid_Real)
+
+/**
+ * Default number of freed vectors kept for reuse when a copy routine is set
+ * (see braid_SetVectorPool)
+ **/
+#define _braid_VPoolDefault  4
+
+/**
+ * Number of cells allocated at once by the vector wrapper slab (see
+ * _braid_SlabAlloc)
+ **/
+#define _braid_SlabChunk 1024
+
+/**
+ * Number of interval blocks per thread (see _braid_ThreadBlocks).  Blocks are
+ * handed to threads as they become free, which balances steps of uneven cost.
+ **/
+#define _braid_ThreadBlockFactor 4
+
+/**
+ * Per-level memory statistics kept in mem_peak (see _braid_GridMemory): bytes
+ * in full vectors, number of shell vectors, bytes saved by storing shells
+ * instead of full vectors, and bytes in communication buffers
+ **/
+#define _braid_MemFull       0
+#define _braid_MemShells     1
+#define _braid_MemShellSaved 2
+#define _braid_MemComm       3
+#define _braid_NMemStats     4
+
+/**
+ * Communication phases.  Each phase on each level uses its own message tag
+ * (see _braid_CommTag), starting at _braid_TagBase to stay clear of the tags
+ * used directly by FRefine.
+ **/
+#define _braid_PhaseRelax     0
+#define _braid_PhaseRestrict  1
+#define _braid_PhaseInterp    2
+#define _braid_PhaseAccess    3
+#define _braid_PhaseResidual  4
+#define _braid_PhaseRefine    5
+#define _braid_PhaseInit      6
+#define _braid_NPhases        7
+#define _braid_TagBase        16
+
+/**
+ * Shared-memory message slots per level and phase (see shm.c).  With two, a
+ * sender can run one message ahead of its receiver.
+ **/
+#define _braid_ShmNBuffers    2
+
+/**
+ * Out-of-core read-ahead buffers (see ooc.c).  With two, the read-ahead of the
+ * next point to the left survives a fetch of the point to the right.
+ **/
+#define _braid_OocNAhead      2
+
+/**
+ * The shared-memory transport (see shm.c) needs MPI-3 shared windows
+ **/
+#if !defined(braid_SEQUENTIAL) && defined(MPI_VERSION) && (MPI_VERSION >= 3)
+#define _braid_SHMEM 1
+#else
+#define _braid_SHMEM 0
+#endif
+
+/**
+ * Storage, communication and memory management are not thread safe, so in
+ * routines that may run on threads (see thread.c) they are placed in a
+ * _braid_Critical section.  Without OpenMP, this is an ordinary block.
+ **/
+#ifdef _OPENMP
+#define _braid_Critical _Pragma("omp critical (braid)")
+#else
+#define _braid_Critical
+#endif
+
 /** 
  * Braid Vector Structures:
  *
@@ -142,9 +227,21 @@ struct _braid_BaseVector_struct
 {
    braid_Vector    userVector;      /**< holds the users primal vector */
    braid_VectorBar bar;             /**< holds the bar vector (shared pointer implementation) */
+   struct _braid_CommHandle_struct *send; /**< zero-copy send still reading userVector, NULL if none (see _braid_CommRelease) */
 };
 typedef struct _braid_BaseVector_struct *braid_BaseVector;
 
+/**
+ * Cell of the core-owned slab that holds the braid_BaseVector and
+ * braid_VectorBar structs.  Free cells are linked through *next*.
+ */
+typedef union _braid_SlabCell_union
+{
+   struct _braid_BaseVector_struct  vector;
+   struct _braid_VectorBar_struct   bar;
+   union _braid_SlabCell_union     *next;
+} _braid_SlabCell;
+
 /** 
  * Data structure for storing the optimization variables
  */
@@ -178,14 +275,28 @@ typedef struct _braid_Optimization_struct *braid_Optim;
  * Used for initiating and completing nonblocking communication to pass
  * braid_BaseVectors between processors.
  **/
-typedef struct
+typedef struct _braid_CommHandle_struct
 {
    braid_Int         request_type;    /**< two values: recv type = 1, and send type = 0 */
    braid_Int         num_requests;    /**< number of active requests for this handle, usually 1 */
    MPI_Request      *requests;        /**< MPI request structure */
    MPI_Status       *status;          /**< MPI status */
    void             *buffer;          /**< Buffer for message */
+   braid_Int         buffer_size;     /**< allocated size of buffer in bytes */
    braid_BaseVector *vector_ptr;      /**< braid_vector being sent/received */
+   braid_BaseVector  vector;          /**< vector received into, or read in place by a zero-copy send until it completes */
+   braid_Vector      user_vector;     /**< user vector of a zero-copy send, taken over when its vector is overwritten or freed first */
+   braid_Int         level;           /**< level whose comm pool owns this handle */
+   braid_Int         persistent;      /**< boolean, requests are persistent (MPI_Send_init/MPI_Recv_init) */
+   braid_Int         active;          /**< boolean, persistent requests have been started and not yet completed */
+   struct _braid_CommHandle_struct *next; /**< next free handle in the comm pool */
+   braid_Int         nvectors;        /**< number of vectors in an aggregated message (0 if not aggregated) */
+   braid_Int         npacked;         /**< number of vectors packed so far into an aggregated send */
+   braid_Int         slot_size;       /**< size in bytes of each vector slot in an aggregated message */
+   braid_Int         proc;            /**< destination of an aggregated send, posted once all vectors are packed */
+   void             *shm_slot;        /**< shared-memory slot of a receive from a neighbor on the same node (see shm.c) */
+   braid_Int         phase;           /**< offset of the active request (persistent handles have one per phase) */
+   braid_BaseVector *agg_ptrs[_braid_CommAggMax]; /**< receive targets of an aggregated message */
    
 } _braid_CommHandle;
 
@@ -208,14 +319,29 @@ typedef struct
 
    braid_Int          nupoints;      /**< number of unknown vector points */
    braid_BaseVector  *ua;            /**< unknown vectors            (C-points at least)*/
+   void             **upack;         /**< packed C-points of ua, in reduced precision or out of core (NULL if not used on this level) */
+   braid_Int         *uspill;        /**< size of each point of upack in the out-of-core file, 0 if in memory (NULL if not used) */
+   void             **uref;          /**< delta storage reference of each group of C-points (NULL if not used on this level) */
    braid_Real        *ta;            /**< time values                (all points) */
    braid_BaseVector  *va;            /**< restricted unknown vectors (all points, NULL on level 0) */
    braid_BaseVector  *fa;            /**< rhs vectors f              (all points, NULL on level 0) */
+   braid_BaseVector   scratch;       /**< work vector for residuals, kept for the life of the grid (NULL until first used) */
 
    braid_Int          recv_index;    /**<  -1 means no receive */
    braid_Int          send_index;    /**<  -1 means no send */
+   braid_Int          fscale;        /**< product of cfactors on finer levels (maps an index to the finest grid), 0 if not set */
+   braid_Int          left_proc;     /**< owner of ilower-1 on this level (-1 if none), valid if fscale > 0 */
+   braid_Int          right_proc;    /**< owner of iupper+1 on this level (-1 if none), valid if fscale > 0 */
+
    _braid_CommHandle *recv_handle;   /**<  Handle for nonblocking receives of braid_BaseVectors */
    _braid_CommHandle *send_handle;   /**<  Handle for nonblocking sends of braid_BaseVectors */
+   _braid_CommHandle *comm_pool;     /**<  Free list of comm handles (and their buffers) reused on this level */
+   _braid_CommHandle *recv_persist;  /**<  Persistent receive from the owner of ilower-1 (if persistent_comm) */
+   _braid_CommHandle *send_persist;  /**<  Persistent send to the owner of iupper+1 (if persistent_comm) */
+   void              *shm_recv;      /**<  Shared-memory slots written by the owner of ilower-1, NULL if not on this node */
+   void              *shm_send;      /**<  Shared-memory slots of the owner of iupper+1, NULL if not on this node */
+   braid_Int          shm_nrecv[_braid_NPhases]; /**<  Shared-memory receives posted in each phase (selects the next slot) */
+   braid_Int          shm_nsend[_braid_NPhases]; /**<  Shared-memory sends made in each phase (selects the next slot) */
 
    braid_BaseVector  *ua_alloc;      /**< original memory allocation for ua */
    braid_Real        *ta_alloc;      /**< original memory allocation for ta */
@@ -235,6 +361,7 @@ typedef struct _braid_Core_struct
    MPI_Comm               comm;             /**< communicator for the time dimension */
    braid_Int              myid_world;       /**< my rank in the world communicator */
    braid_Int              myid;             /**< my rank in the time communicator */
+   braid_Int              nprocs;           /**< number of processors in the time communicator */
    braid_Real             tstart;           /**< start time */
    braid_Real             tstop;            /**< stop time */
    braid_Int              ntime;            /**< initial number of time intervals */
@@ -253,6 +380,8 @@ typedef struct _braid_Core_struct
    braid_PtFcnBufSize     bufsize;          /**< return buffer size */
    braid_PtFcnBufPack     bufpack;          /**< pack a buffer */
    braid_PtFcnBufUnpack   bufunpack;        /**< unpack a buffer */
+   braid_PtFcnBufView     bufview;          /**< (optional) return a contiguous view of a vector, for zero-copy messages */
+   braid_PtFcnCopy        copy;             /**< (optional) copy into an existing vector, turns on vector recycling */
    braid_PtFcnResidual    residual;         /**< (optional) compute residual */
    braid_PtFcnSCoarsen    scoarsen;         /**< (optional) return a spatially coarsened vector */
    braid_PtFcnSRefine     srefine;          /**< (optional) return a spatially refined vector */
@@ -272,6 +401,8 @@ typedef struct _braid_Core_struct
    braid_Int              rtol;             /**< use relative tolerance */
    braid_Int             *nrels;            /**< number of pre-relaxations on each level */
    braid_Int              nrdefault;        /**< default number of pre-relaxations */
+   char                 **rscheds;          /**< relaxation schedule on each level (NULL if not set) */
+   char                  *rsdefault;        /**< default relaxation schedule (NULL if not set) */
    braid_Real            *CWts;             /**< C-relaxation weight for each level */
    braid_Real             CWt_default;      /**< default C-relaxtion weight */
    braid_Int             *cfactors;         /**< coarsening factors */
@@ -281,6 +412,10 @@ typedef struct _braid_Core_struct
    braid_Int              fmg;              /**< use FMG cycle */
    braid_Int              nfmg;             /**< number of fmg cycles to do initially before switching to V-cycles */
    braid_Int              nfmg_Vcyc;        /**< number of V-cycle calls at each level in FMG */
+   braid_Int              cycle;            /**< cycle type (braid_CYCLE_V, braid_CYCLE_F or braid_CYCLE_W) */
+   braid_Int             *ncycles;          /**< number of coarse-grid corrections on each level */
+   braid_Int              ncdefault;        /**< default number of coarse-grid corrections (-1 uses the cycle type) */
+   braid_Real            *nvisits;          /**< number of times each level was relaxed (or solved on the coarsest level) */
    braid_Int              warm_restart;     /**< boolean, indicates whether this is a warm restart of an existing braid_Core */
    braid_Int              tnorm;            /**< choice of temporal norm */
    braid_Real            *tnorm_a;          /**< local array of residual norms on a proc's interval, used for inf-norm */
@@ -290,8 +425,61 @@ typedef struct _braid_Core_struct
    braid_Real             full_rnorm0;      /**< (optional) initial full residual norm */
    braid_Real            *full_rnorms;      /**< (optional) full residual norm history */
 
+   braid_BaseVector      *vpool;            /**< freed vectors kept for reuse by _braid_BaseClone (if copy is set) */
+   braid_Int             *vpool_keys;       /**< key of each vector in vpool (see _braid_BasePoolKey) */
+   braid_Int              vpool_size;       /**< number of vectors in vpool */
+   braid_Int              vpool_max;        /**< capacity of vpool */
+   _braid_SlabCell      **slab_chunks;      /**< chunks of _braid_SlabChunk cells holding vector wrappers and bars */
+   braid_Int              slab_nchunks;     /**< number of slab chunks */
+   _braid_SlabCell       *slab_free;        /**< free list of slab cells */
+   braid_Int              slab_used;        /**< number of slab cells in use */
+   braid_Int              slab_peak;        /**< peak number of slab cells in use */
+   braid_Real             gslab_stats[3];   /**< max over processors of slab_used, slab_peak and allocated cells, set at the end of braid_Drive */
+
    braid_Int              storage;          /**< storage = 0 (C-points), = 1 (all) */
    braid_Int              useshell;         /**< activate the shell structure of vectors */
+   braid_Int              reduced_storage;  /**< store C-points on levels >= reduced_storage in reduced precision (-1 is off) */
+   char                  *ooc_path;         /**< prefix of the out-of-core file for level 0 C-points (NULL is off) */
+   braid_Int              ooc_window;       /**< number of local level 0 C-points kept in memory when out of core */
+   int                    ooc_fd;           /**< out-of-core file descriptor, -1 if not open */
+   braid_Int              ooc_slot_size;    /**< size in bytes of the file slot of each point */
+   void                  *ooc_ahead;        /**< read-ahead of the next point (see ooc.c), NULL if the file is not open */
+   braid_Real             ooc_stats[4];     /**< local bytes spilled, bytes fetched, time stalled on fetches, and bytes fetched from the read-ahead */
+   braid_Real             gooc_stats[4];    /**< global ooc_stats (sum of bytes, max time), set at the end of braid_Drive */
+   braid_Int              delta_keyframe;   /**< number of level 0 C-points per delta storage group (0 is off) */
+   braid_PtFcnDeltaEncode delta_encode;     /**< (optional) user delta encoding, NULL for the default codec */
+   braid_PtFcnDeltaDecode delta_decode;     /**< (optional) user delta decoding, NULL for the default codec */
+   braid_Real             gdelta_stats[2];  /**< global bytes of the level 0 C-points in delta storage, and bytes stored, set at the end of braid_Drive */
+   braid_Int              persistent_comm;  /**< use persistent MPI requests for the neighbor exchange */
+   braid_Int              comm_agg;         /**< aggregate messages to the same neighbor within a phase */
+   braid_Int              comm_phase;       /**< current communication phase (_braid_PhaseRelax, ...) */
+   braid_Int              shm;              /**< use shared memory for neighbors on the same node */
+   braid_Int              thread_safe;      /**< user Step (and Residual) may run on several threads at once */
+   MPI_Comm               shm_comm;         /**< processors of comm on this node */
+#if _braid_SHMEM
+   MPI_Win                shm_win;          /**< shared window with the message slots of this node */
+#endif
+   braid_Int              shm_slot_size;    /**< size in bytes of each message slot, 0 if shared memory is not in use */
+   braid_Int              compress;         /**< compression of vector messages (braid_COMPRESS_NONE, _LOSSLESS, _LOSSY) */
+   braid_Real             compress_tol;     /**< lossy compression error, relative to the current residual norm */
+   braid_Int              packed_reals;     /**< my_BufPack writes only braid_Reals, required for lossy compression */
+   void                  *comp_buffer;      /**< scratch buffer for packed data before compression / after decompression */
+   braid_Int              comp_buffer_size; /**< allocated size of comp_buffer in bytes */
+   void                  *store_buffer;     /**< scratch buffer for packed data of stored vectors (reduced or delta) */
+   braid_Int              store_buffer_size;/**< allocated size of store_buffer in bytes */
+   void                  *comp_words;       /**< work array used by the compression codecs */
+   braid_Int              comp_nwords;      /**< allocated length of comp_words */
+   braid_Real             comp_stats[3];    /**< local bytes packed, bytes sent, and time spent in (de)compression */
+   braid_Real             gcomp_stats[3];   /**< global comp_stats (sum of bytes, max time), set at the end of braid_Drive */
+   braid_Real            *recv_wait;        /**< time spent waiting on receives (in MPI_Waitall) on each level */
+   braid_Real            *grecv_wait;       /**< max of recv_wait over all processors, set at the end of braid_Drive */
+   braid_Real            *mem_peak;         /**< peak memory statistics on each level, _braid_NMemStats per level */
+   braid_Real            *gmem_peak;        /**< sum of mem_peak over all processors, set at the end of braid_Drive */
+   braid_Real            *ncalls;           /**< number of calls to each user callback on each level, braid_NCalls per level */
+   braid_Real            *gncalls;          /**< sum of ncalls over all processors, set at the end of braid_Drive */
+   braid_Int              nlive;            /**< number of user vectors currently allocated */
+   braid_Int              nlive_peak;       /**< peak of nlive */
+   braid_Real             glive_peak[2];    /**< max over processors of nlive_peak and of its estimated bytes, set at the end of braid_Drive */
 
    braid_Int              gupper;           /**< global size of the fine grid */
 
@@ -330,33 +518,13 @@ typedef struct _braid_Core_struct
    braid_PtFcnStepDiff                  step_diff;            /**< User function: apply differentiated step function */
    braid_PtFcnObjectiveTDiff            objT_diff;            /**< User function: apply differentiated objective function */
    braid_PtFcnResetGradient             reset_gradient;       /**< User function: Set the gradient to zero. Is called before each iteration */
+   braid_PtFcnInitZero                  init_zero;            /**< (optional) User function: allocate a zero vector, used for bar vectors */
    braid_PtFcnPostprocessObjective      postprocess_obj;      /**< Optional user function: Modify the time-averaged objective function, e.g. for inverse design problems, adding relaxation term etc. */
    braid_PtFcnPostprocessObjective_diff postprocess_obj_diff; /**< Optional user function: Derivative of postprocessing function  */
 
-   /** Data elements required for the Status structures */
-   /** Common Status properties */
-   braid_Real    t;                /**< current time */
-   braid_Int     idx;              /**< time point index value corresponding to t on the global time grid */
-   braid_Int     level;            /**< current level in XBraid*/
-   /** AccessStatus properties */
-   braid_Real    rnorm;            /**< residual norm */
-   braid_Int     done;             /**< boolean describing whether XBraid has finished */
-   braid_Int     wrapper_test;     /**< boolean describing whether this call is only a wrapper test */
-   braid_Int     calling_function; /**< from which function are we accessing the vector */
-   /** CoarsenRefStatus properties*/
-   braid_Real    f_tprior;         /**< time value to the left of tstart on fine grid */
-   braid_Real    f_tstop;          /**< time value to the right of tstart  on fine grid */
-   braid_Real    c_tprior;         /**< time value to the left of tstart on coarse grid */
-   braid_Real    c_tstop;          /**< time value to the right of tstart on coarse grid */
-   /** StepStatus properties */
-   braid_Real    tnext;            /**< time value to evolve towards, time value to the right of tstart */
+   /** Step state the user sets through the StepStatus (see _braid_StepStatusDone) */
    braid_Real    old_fine_tolx;    /**< Allows for storing the previously used fine tolerance from GetSpatialAccuracy */
    braid_Int     tight_fine_tolx;  /**< Boolean, indicating whether the tightest fine tolx has been used, condition for halting */
-   braid_Int     rfactor;          /**< if set by user, allows for subdivision of this interval for better time accuracy */
-   /** BufferStatus properties */
-   braid_Int    messagetype;       /**< message type, 0: for Step(), 1: for load balancing */
-   braid_Int    size_buffer;       /**< if set by user, send buffer will be "size" bytes in length */
-   braid_Int    send_recv_rank;    /***< holds the rank of the source / receiver from MPI_Send / MPI_Recv calls. */
 } _braid_Core;
 
 /*--------------------------------------------------------------------------
@@ -383,6 +551,28 @@ typedef struct _braid_Core_struct
  **/
 #define _braid_CoreFcn(core, fcn)     (*((core)  -> fcn))
 
+/**
+ * Accessor for _braid_Core user functions that also counts the call (see
+ * _braid_CountCall).  The _braid_Call_<fcn> names map each function pointer
+ * of the core to its braid_Call_* counter.
+ **/
+#define _braid_CountFcn(core, fcn)    (_braid_CountCall(core, _braid_Call_##fcn), _braid_CoreFcn(core, fcn))
+
+#define _braid_Call_init        braid_Call_Init
+#define _braid_Call_init_zero   braid_Call_Init
+#define _braid_Call_sinit       braid_Call_Init
+#define _braid_Call_clone       braid_Call_Clone
+#define _braid_Call_sclone      braid_Call_Clone
+#define _braid_Call_copy        braid_Call_Copy
+#define _braid_Call_free        braid_Call_Free
+#define _braid_Call_sum         braid_Call_Sum
+#define _braid_Call_spatialnorm braid_Call_SpatialNorm
+#define _braid_Call_bufpack     braid_Call_BufPack
+#define _braid_Call_bufunpack   braid_Call_BufUnpack
+#define _braid_Call_step        braid_Call_Step
+#define _braid_Call_scoarsen    braid_Call_SCoarsen
+#define _braid_Call_srefine     braid_Call_SRefine
+
 /*--------------------------------------------------------------------------
  * Print file for redirecting stdout when needed
  *--------------------------------------------------------------------------*/
@@ -482,6 +672,15 @@ _braid_GetProc(braid_Core   core,
                braid_Int    index,
                braid_Int   *proc_ptr);
 
+/**
+ * Cache the map to the finest grid and the neighbor ranks (owners of ilower-1
+ * and iupper+1) on each grid level, so that _braid_GetProc does not have to
+ * walk the hierarchy.  Called when the hierarchy is (re)built, which also
+ * invalidates the old values after refinement.
+ */
+braid_Int
+_braid_InitProcCache(braid_Core  core);
+
 /* communication.c */
 
 /**
@@ -508,6 +707,16 @@ _braid_CommSendInit(braid_Core           core,
                     braid_BaseVector     vector,
                     _braid_CommHandle  **handle_ptr);
 
+/**
+ * Called before *u* is overwritten (*keep* = 1) or freed (*keep* = 0) while a
+ * zero-copy send still reads it.  The send takes over the user vector of *u*,
+ * and *u* gets a clone of it if *keep* is set.
+ */
+braid_Int
+_braid_CommRelease(braid_Core        core,
+                   braid_BaseVector  u,
+                   braid_Int         keep);
+
 /**
  * Block on the comm handle *handle_ptr* until the MPI operation (send or recv)
  * has completed
@@ -516,6 +725,317 @@ braid_Int
 _braid_CommWait(braid_Core         core,
                _braid_CommHandle **handle_ptr);
 
+/**
+ * Test the comm handle *handle_ptr* without blocking.  If the MPI operation
+ * has completed, finish it as _braid_CommWait would (a received vector is
+ * unpacked) and set *handle_ptr* to NULL.  Otherwise, this only gives MPI a
+ * chance to make progress on the message.
+ */
+braid_Int
+_braid_CommTest(braid_Core         core,
+                _braid_CommHandle **handle_ptr);
+
+/**
+ * Initialize one receive from the owner of *index* on *level* that carries
+ * *nvectors* vectors, unpacked into *vector_ptrs[i]* by _braid_CommWait.
+ * The sender must use _braid_CommSendInitAgg with the same *nvectors*.
+ */
+braid_Int
+_braid_CommRecvInitAgg(braid_Core           core,
+                       braid_Int            level,
+                       braid_Int            index,
+                       braid_Int            nvectors,
+                       braid_BaseVector   **vector_ptrs,
+                       _braid_CommHandle  **handle_ptr);
+
+/**
+ * Initialize an aggregated send of *nvectors* vectors to the owner of
+ * *index+1* on *level*.  Nothing is sent until all vectors have been packed
+ * with _braid_CommSendAppend.
+ */
+braid_Int
+_braid_CommSendInitAgg(braid_Core           core,
+                       braid_Int            level,
+                       braid_Int            index,
+                       braid_Int            nvectors,
+                       _braid_CommHandle  **handle_ptr);
+
+/**
+ * Pack *vector* into *slot* of the aggregated send *handle*.  The message is
+ * posted once every slot has been packed.
+ */
+braid_Int
+_braid_CommSendAppend(braid_Core          core,
+                      _braid_CommHandle  *handle,
+                      braid_Int           slot,
+                      braid_BaseVector    vector);
+
+/**
+ * Return in *tag_ptr* the message tag for *level* in the current
+ * communication phase
+ */
+braid_Int
+_braid_CommTag(braid_Core   core,
+               braid_Int    level,
+               braid_Int   *tag_ptr);
+
+/**
+ * Get a comm handle from the pool on *level* with a buffer of at least *size*
+ * bytes.  Handles are returned to the pool by _braid_CommWait, so buffers and
+ * MPI request storage are only allocated the first time (or when a larger
+ * *size* is requested).
+ */
+braid_Int
+_braid_CommHandleGet(braid_Core           core,
+                     braid_Int            level,
+                     braid_Int            size,
+                     _braid_CommHandle  **handle_ptr);
+
+/**
+ * Set up persistent MPI requests on *level* for the fixed neighbor exchange:
+ * receive from the owner of ilower-1 and send to the owner of iupper+1, with
+ * one request per communication phase.
+ * Called at the end of _braid_InitHierarchy when persistent_comm is set, so
+ * the requests are rebuilt whenever the hierarchy is (e.g., after refinement).
+ */
+braid_Int
+_braid_CommPersistentInit(braid_Core  core,
+                          braid_Int   level);
+
+/**
+ * Free all comm handles (and buffers) stored in the comm pool of *grid*,
+ * including any persistent requests
+ */
+braid_Int
+_braid_CommPoolDestroy(_braid_Grid  *grid);
+
+/* shm.c */
+
+/**
+ * Set up the shared-memory message slots for neighbors on the same node,
+ * _braid_ShmNBuffers per level and phase.  Called at the end of _braid_InitHierarchy (collective), which
+ * also releases the slots of a previous hierarchy.
+ */
+braid_Int
+_braid_ShmInit(braid_Core  core);
+
+/**
+ * Release the shared window and node communicator
+ */
+braid_Int
+_braid_ShmDestroy(braid_Core  core);
+
+/**
+ * Return in *fits_ptr* whether a message of *size* bytes fits in a slot
+ */
+braid_Int
+_braid_ShmFits(braid_Core   core,
+               braid_Int    size,
+               braid_Int   *fits_ptr);
+
+/**
+ * Return in *slot_ptr* the next slot of the current phase on *level*, for a
+ * receive from the left neighbor (*recv* = 1) or a send to the right one
+ */
+braid_Int
+_braid_ShmNextSlot(braid_Core   core,
+                   braid_Int    level,
+                   braid_Int    recv,
+                   void       **slot_ptr);
+
+/**
+ * Pack *vector* straight into the neighbor's *slot* and mark it full, waiting
+ * first for the previous message in the slot to be consumed
+ */
+braid_Int
+_braid_ShmSend(braid_Core        core,
+               void             *slot,
+               braid_Int         proc,
+               braid_BaseVector  vector);
+
+/**
+ * Return in *flag_ptr* whether *slot* holds a message, without blocking
+ */
+braid_Int
+_braid_ShmTest(braid_Core   core,
+               void        *slot,
+               braid_Int   *flag_ptr);
+
+/**
+ * Wait for a message in *slot*, unpack it into *vector_ptr* and free the slot
+ */
+braid_Int
+_braid_ShmRecv(braid_Core         core,
+               void              *slot,
+               braid_BaseVector  *vector_ptr);
+
+/* compress.c */
+
+/**
+ * Return in *bound_ptr* the largest size in bytes of a compressed message
+ * holding *raw_size* bytes of packed data
+ */
+braid_Int
+_braid_CompressBound(braid_Int   raw_size,
+                     braid_Int  *bound_ptr);
+
+/**
+ * Return in *buffer_ptr* a scratch buffer of at least *size* bytes, owned by
+ * the core and reused between messages
+ */
+braid_Int
+_braid_CompressScratch(braid_Core   core,
+                       braid_Int    size,
+                       void       **buffer_ptr);
+
+/**
+ * Return in *buffer_ptr* a scratch buffer of at least *size* bytes for packing
+ * and unpacking stored vectors.  It is separate from the message buffer of
+ * _braid_CompressScratch, so stored vectors can be (un)packed while a message
+ * is being (de)compressed.
+ */
+braid_Int
+_braid_StorageScratch(braid_Core   core,
+                      braid_Int    size,
+                      void       **buffer_ptr);
+
+/**
+ * Compress *raw_size* bytes of packed data *raw* into *comp* (of at least
+ * _braid_CompressBound bytes) with the method set by braid_SetCompression.
+ * The message size is returned in *comp_size_ptr*.
+ */
+braid_Int
+_braid_Compress(braid_Core   core,
+                void        *raw,
+                braid_Int    raw_size,
+                void        *comp,
+                braid_Int   *comp_size_ptr);
+
+/**
+ * Decompress the message *comp* into the core scratch buffer, returned in
+ * *raw_ptr* along with the size of the packed data in *raw_size_ptr*
+ */
+braid_Int
+_braid_Decompress(braid_Core   core,
+                  void        *comp,
+                  void       **raw_ptr,
+                  braid_Int   *raw_size_ptr);
+
+/**
+ * Return in *bound_ptr* the largest size in bytes of the buffer returned by
+ * _braid_ReducePrecision for *raw_size* bytes of packed data
+ */
+braid_Int
+_braid_ReducedBound(braid_Int   raw_size,
+                    braid_Int  *bound_ptr);
+
+/**
+ * Store *raw_size* bytes of packed data *raw* in reduced (single) precision if
+ * *reduce* is true, otherwise copy it.  The new buffer is returned in
+ * *packed_ptr*, with its size in *packed_size_ptr*, and must be freed by the
+ * caller.
+ */
+braid_Int
+_braid_ReducePrecision(braid_Core   core,
+                       void        *raw,
+                       braid_Int    raw_size,
+                       braid_Int    reduce,
+                       void       **packed_ptr,
+                       braid_Int   *packed_size_ptr);
+
+/**
+ * Expand the buffer *packed* (from _braid_ReducePrecision) into the core
+ * scratch buffer, returned in *raw_ptr* along with its size in *raw_size_ptr*
+ */
+braid_Int
+_braid_ExpandPrecision(braid_Core   core,
+                       void        *packed,
+                       void       **raw_ptr,
+                       braid_Int   *raw_size_ptr);
+
+/**
+ * Encode *raw_size* bytes of packed data *raw* as a difference to the
+ * reference buffer *ref* (from a previous call with *ref* = NULL, which just
+ * copies the data), see braid_SetDeltaStorage.  The new buffer is returned in
+ * *packed_ptr*, with its size in *packed_size_ptr*, and must be freed by the
+ * caller.
+ */
+braid_Int
+_braid_DeltaEncode(braid_Core   core,
+                   void        *ref,
+                   void        *raw,
+                   braid_Int    raw_size,
+                   void       **packed_ptr,
+                   braid_Int   *packed_size_ptr);
+
+/**
+ * Decode the buffer *packed* (from _braid_DeltaEncode with reference *ref*)
+ * into the core scratch buffer, returned in *raw_ptr* along with its size in
+ * *raw_size_ptr*
+ */
+braid_Int
+_braid_DeltaDecode(braid_Core   core,
+                   void        *ref,
+                   void        *packed,
+                   void       **raw_ptr,
+                   braid_Int   *raw_size_ptr);
+
+/**
+ * Return the size in bytes of the data encoded in *packed* (from
+ * _braid_DeltaEncode), and the size of *packed* itself
+ */
+braid_Int
+_braid_DeltaSizes(void        *packed,
+                  braid_Int   *raw_size_ptr,
+                  braid_Int   *size_ptr);
+
+/**
+ * Return in *raw_ptr* the data of the reference buffer *ref* (from
+ * _braid_DeltaEncode with a NULL reference), along with its size in
+ * *raw_size_ptr*
+ */
+braid_Int
+_braid_DeltaData(void        *ref,
+                 void       **raw_ptr,
+                 braid_Int   *raw_size_ptr);
+
+/* ooc.c */
+
+/**
+ * Open the out-of-core file of this processor (see braid_SetOutOfCore), if
+ * set and not done yet, and allocate the spill information of level 0
+ */
+braid_Int
+_braid_OocInit(braid_Core  core);
+
+/**
+ * Close the out-of-core file
+ */
+braid_Int
+_braid_OocDestroy(braid_Core  core);
+
+/**
+ * Write the packed point *iu* of grid *level* (*size* bytes in **slot_ptr*)
+ * to the out-of-core file and free it, unless the point stays in memory
+ */
+braid_Int
+_braid_OocSpill(braid_Core   core,
+                braid_Int    level,
+                braid_Int    iu,
+                braid_Int    size,
+                void       **slot_ptr);
+
+/**
+ * Read the packed point *iu* of grid *level* from the out-of-core file into a
+ * new buffer returned in *packed_ptr* (NULL if the point is not on file), and
+ * start reading the next point to the left ahead
+ */
+braid_Int
+_braid_OocFetch(braid_Core   core,
+                braid_Int    level,
+                braid_Int    iu,
+                void       **packed_ptr);
+
 /* uvector.c */
 
 /**
@@ -531,8 +1051,31 @@ _braid_UGetIndex(braid_Core   core,
                  braid_Int   *uindex_ptr,
                  braid_Int   *store_flag_ptr);
 
+/**
+ * Stores the C-points *ilo* to *ihi* on grid *level* that were expanded by
+ * _braid_UGetVectorRef back in packed form (see braid_SetReducedStorage,
+ * braid_SetOutOfCore and braid_SetDeltaStorage).  No references to these vectors may be held.
+ */
+braid_Int
+_braid_URepack(braid_Core  core,
+               braid_Int   level,
+               braid_Int   ilo,
+               braid_Int   ihi);
+
+/**
+ * Returns in *stats* the bytes of the packed data of the C-points in delta
+ * storage on grid *level* (see braid_SetDeltaStorage), and the bytes actually
+ * stored for them, including the group references
+ */
+braid_Int
+_braid_UDeltaStats(braid_Core   core,
+                   braid_Int    level,
+                   braid_Real  *stats);
+
 /**
  * Returns a reference to the local u-vector on grid *level* at point *index*.
+ * If the u-vector is stored packed, it is expanded first and kept as a vector
+ * until it is set again or _braid_URepack is called.
  * If the u-vector is not stored, returns NULL.
  */
 braid_Int
@@ -609,6 +1152,28 @@ braid_Int
 _braid_UCommInitF(braid_Core  core,
                   braid_Int   level);
 
+/**
+ * Same as _braid_UCommInit, but the messages also carry the coarse-grid
+ * boundary value used in _braid_FRestrict.  If *recv_agg* is true, the receive
+ * also unpacks into *c_vector_ptr*.  If *send_agg* is true, the send is posted
+ * once the coarse-grid vector has been appended to slot 1 of the send handle.
+ */
+braid_Int
+_braid_UCommInitAgg(braid_Core         core,
+                    braid_Int          level,
+                    braid_Int          recv_agg,
+                    braid_Int          send_agg,
+                    braid_BaseVector  *c_vector_ptr);
+
+/**
+ * Make progress on the outstanding recv and send on *level* without blocking,
+ * so messages complete while local intervals are being computed.  A completed
+ * receive is unpacked into its target, ready for _braid_UGetVector.
+ */
+braid_Int
+_braid_UCommProgress(braid_Core  core,
+                     braid_Int   level);
+
 /**
  * Finish up communication.  On *level*, wait on both the recv and send handles
  * at this level.
@@ -730,6 +1295,35 @@ _braid_GridInit(braid_Core     core,
                 braid_Int      iupper,
                 _braid_Grid  **grid_ptr);
 
+/**
+ * Measure the memory held on *grid* (full vectors, shells and communication
+ * buffers) and update the peak statistics for its level
+ */
+braid_Int
+_braid_GridMemory(braid_Core    core,
+                  _braid_Grid  *grid);
+
+/**
+ * Get a work vector on *grid* holding a copy of *u*.  If vectors can be
+ * recycled (see _braid_BasePoolOn), this is the grid's scratch vector,
+ * overwritten through the copy routine.  Otherwise, *u* is cloned.  Release
+ * with _braid_GridScratchFree.
+ */
+braid_Int
+_braid_GridScratch(braid_Core         core,
+                   _braid_Grid       *grid,
+                   braid_BaseVector   u,
+                   braid_BaseVector  *r_ptr);
+
+/**
+ * Release a work vector from _braid_GridScratch (the scratch vector itself is
+ * kept until _braid_GridDestroy)
+ */
+braid_Int
+_braid_GridScratchFree(braid_Core         core,
+                       _braid_Grid       *grid,
+                       braid_BaseVector   r);
+
 /**
  * Destroy the vectors on *grid*
  */
@@ -799,10 +1393,71 @@ _braid_PrintSpatialNorms(braid_Core    core,
                          braid_Real   *rnorms,
                          braid_Int     n);
 
+/* thread.c */
+
+/**
+ * Per-interval work of a relaxation, restriction or interpolation routine on
+ * *level*.  Storage is accessed through *core* in _braid_Critical sections.
+ */
+typedef braid_Int (*_braid_IntervalFcn)(braid_Core  core,
+                                        braid_Int   level,
+                                        braid_Int   interval,
+                                        void       *data);
+
+/**
+ * Return in [*tlo_ptr*, *thi_ptr*] the intervals on *level* that are done by
+ * threads, or an empty range (*tlo_ptr* > *thi_ptr*) if threads are not used.
+ * These are all but the first interval, which receives from the left
+ * neighbor, and the last two, which hold the point sent to the right neighbor.
+ * Threads need OpenMP and braid_SetThreadSafe, and are not used for adjoint or
+ * periodic runs.
+ */
+braid_Int
+_braid_ThreadIntervals(braid_Core  core,
+                       braid_Int   level,
+                       braid_Int  *tlo_ptr,
+                       braid_Int  *thi_ptr);
+
+/**
+ * Return in *nblocks_ptr* the number of blocks the intervals [tlo, thi] are
+ * split into, _braid_ThreadBlockFactor per thread but no more than the number
+ * of intervals
+ */
+braid_Int
+_braid_ThreadBlocks(braid_Int   tlo,
+                    braid_Int   thi,
+                    braid_Int  *nblocks_ptr);
+
+/**
+ * Return in [*blo_ptr*, *bhi_ptr*] the intervals of block *block* out of
+ * *nblocks* contiguous blocks of [tlo, thi]
+ */
+braid_Int
+_braid_ThreadBlock(braid_Int   tlo,
+                   braid_Int   thi,
+                   braid_Int   nblocks,
+                   braid_Int   block,
+                   braid_Int  *blo_ptr,
+                   braid_Int  *bhi_ptr);
+
+/**
+ * Call *fcn* for the intervals [tlo, thi] on *level* using threads.  Each
+ * block (see _braid_ThreadBlock) is done by one thread from right to left,
+ * like the sequential loops, and blocks go to whichever thread is free next.
+ */
+braid_Int
+_braid_ThreadLoop(braid_Core          core,
+                  braid_Int           level,
+                  braid_Int           tlo,
+                  braid_Int           thi,
+                  _braid_IntervalFcn  fcn,
+                  void               *data);
+
 /* relax.c */
 
 /**
- * Do nu sweeps of F-then-C relaxation on *level*
+ * Do nu sweeps of F-then-C relaxation on *level*, or the sweeps of the
+ * relaxation schedule if one is set (see braid_SetRelaxSchedule)
  */
 braid_Int
 _braid_FCRelax(braid_Core  core,
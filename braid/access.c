@@ -33,8 +33,10 @@ _braid_FAccess(braid_Core     core,
 {
    braid_App              app          = _braid_CoreElt(core, app);
    _braid_Grid          **grids        = _braid_CoreElt(core, grids);
-   braid_AccessStatus     astatus      = (braid_AccessStatus)core;
-   braid_ObjectiveStatus  ostatus      = (braid_ObjectiveStatus)core;
+   _braid_AccessStatus    astatus_s;
+   braid_AccessStatus     astatus      = &astatus_s;
+   _braid_ObjectiveStatus ostatus_s;
+   braid_ObjectiveStatus  ostatus      = &ostatus_s;
    braid_Int              iter         = _braid_CoreElt(core, niter);
    braid_Int              nrefine      = _braid_CoreElt(core, nrefine);
    braid_Int              gupper       = _braid_CoreElt(core, gupper);
@@ -47,6 +49,11 @@ _braid_FAccess(braid_Core     core,
    braid_BaseVector  u;
    braid_Int         interval, flo, fhi, fi, ci;
 
+   _braid_StatusInit(core, (braid_Status) astatus);
+   _braid_StatusInit(core, (braid_Status) ostatus);
+
+   _braid_CoreElt(core, comm_phase) = _braid_PhaseAccess;
+   _braid_SetCallLevel(level, NULL);
    _braid_UCommInitF(core, level);
    
    _braid_GetRNorm(core, -1, &rnorm);
@@ -105,6 +112,9 @@ _braid_FAccess(braid_Core     core,
             _braid_ObjectiveStatusInit(ta[ci-ilower], ci, iter, level, nrefine, gupper, ostatus);
             _braid_AddToObjective(core, u, ostatus);
          }
+
+         /* Pack the C-point again (if stored packed) */
+         _braid_URepack(core, level, ci, ci);
       }
    }
    _braid_UCommWait(core, level);
@@ -34,6 +34,32 @@ _braid_VectorBarCopy(braid_VectorBar bar, braid_VectorBar *bar_ptr)
    return _braid_error_flag;
 }
 
+/*----------------------------------------------------------------------------
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_VectorBarInit(braid_Core core, braid_Real t, braid_VectorBar bar)
+{
+   braid_App app = _braid_CoreElt(core, app);
+
+   if (bar->userVector != NULL)
+   {
+      return _braid_error_flag;
+   }
+
+   if (_braid_CoreElt(core, init_zero) != NULL)
+   {
+      _braid_CountFcn(core, init_zero)(app, t, &(bar->userVector));
+   }
+   else
+   {
+      _braid_CountFcn(core, init)(app, t, &(bar->userVector));
+      _braid_CountFcn(core, sum)(app, -1.0, bar->userVector, 1.0, bar->userVector);
+   }
+
+   return _braid_error_flag;
+}
+
 /*----------------------------------------------------------------------------
  *----------------------------------------------------------------------------*/
 
@@ -46,8 +72,11 @@ _braid_VectorBarDelete(braid_Core core, braid_VectorBar bar)
    /* Free memory, if no pointer is left */
    if (bar->useCount==0)
    {
-      _braid_CoreFcn(core, free)(_braid_CoreElt(core, app), bar->userVector);
-      free(bar);
+      if (bar->userVector != NULL)
+      {
+         _braid_CountFcn(core, free)(_braid_CoreElt(core, app), bar->userVector);
+      }
+      _braid_SlabFree(core, bar);
    }
  
    /* Sanity check */
@@ -108,7 +137,7 @@ _braid_OptimDestroy( braid_Core core)
          if (destroy_flag)
          {
             _braid_UGetIndex(core, 0, ic, &iclocal, &sflag);
-            _braid_CoreFcn(core, free)( app, optim->adjoints[iclocal]);
+            _braid_CountFcn(core, free)( app, optim->adjoints[iclocal]);
             _braid_VectorBarDelete(core, optim->tapeinput[iclocal] );
          }
       }
@@ -186,14 +215,16 @@ _braid_UpdateAdjoint(braid_Core core,
          /* Get the local index of the points */
          _braid_UGetIndex(core, 0, ic, &iclocal, &sflag);
 
+         /* The bar may never have been written to (lazily zero) */
+         _braid_VectorBarInit(core, _braid_CoreElt(core, tstart), optim->tapeinput[iclocal]);
          tape_vec    = optim->tapeinput[iclocal]->userVector;   
          adjoint_vec = optim->adjoints[iclocal];
 
          if (ic > 0)
          {
             /* Compute the norm of the adjoint residual */
-            _braid_CoreFcn(core, sum)(app, 1., tape_vec, -1., adjoint_vec);
-            _braid_CoreFcn(core, spatialnorm)(app, adjoint_vec, &rnorm_temp);
+            _braid_CountFcn(core, sum)(app, 1., tape_vec, -1., adjoint_vec);
+            _braid_CountFcn(core, spatialnorm)(app, adjoint_vec, &rnorm_temp);
             if(tnorm == 1)       /* one-norm */ 
             {  
                rnorm_adj += rnorm_temp;
@@ -208,7 +239,7 @@ _braid_UpdateAdjoint(braid_Core core,
             }
 
             /* Update the adjoint variables */
-            _braid_CoreFcn(core, sum)(app, 1., tape_vec , 0., adjoint_vec);
+            _braid_CountFcn(core, sum)(app, 1., tape_vec , 0., adjoint_vec);
          }
 
          /* Delete the pointer */
@@ -278,7 +309,7 @@ _braid_AddToObjective(braid_Core              core,
 {
    braid_App   app        = _braid_CoreElt(core, app);
    braid_Optim optim      = _braid_CoreElt(core, optim);
-   braid_Real  t          = _braid_CoreElt(core, t);
+   braid_Real  t          = _braid_StatusElt(ostatus, t);
    braid_Real  tstart_obj = optim->tstart_obj;
    braid_Real  tstop_obj  = optim->tstop_obj;
    braid_Real  objT;
@@ -387,7 +418,8 @@ _braid_InitAdjointVars(braid_Core   core,
    braid_Int           iupper    = _braid_GridElt(fine_grid, iupper);
    braid_Int           ilower    = _braid_GridElt(fine_grid, ilower);
    braid_Int           cfactor   = _braid_GridElt(fine_grid, cfactor);
-   braid_BufferStatus  bstatus   = (braid_BufferStatus) core;
+   _braid_BufferStatus bstatus_s;
+   braid_BufferStatus  bstatus   = &bstatus_s;
    braid_Vector       *adjoints  = NULL; 
    braid_VectorBar    *tapeinput = NULL; 
    braid_BaseVector    u; 
@@ -398,6 +430,7 @@ _braid_InitAdjointVars(braid_Core   core,
    void*               sendbuffer;
    MPI_Request*        request;
   
+   _braid_StatusInit(core, (braid_Status) bstatus);
 
    /* Get the number of adjoint vectors on finest level */
    if (storage < 0 ) 
@@ -441,8 +474,15 @@ _braid_InitAdjointVars(braid_Core   core,
          _braid_UGetIndex(core, 0, ic, &iclocal, &sflag);
 
          /* Initialize adjoint variables with zeros */
-         _braid_CoreFcn(core, init)(app, tstart, &mybar);
-         _braid_CoreFcn(core, sum)( app, -1.0, mybar, 1.0, mybar);
+         if (_braid_CoreElt(core, init_zero) != NULL)
+         {
+            _braid_CountFcn(core, init_zero)(app, tstart, &mybar);
+         }
+         else
+         {
+            _braid_CountFcn(core, init)(app, tstart, &mybar);
+            _braid_CountFcn(core, sum)( app, -1.0, mybar, 1.0, mybar);
+         }
          adjoints[iclocal] = mybar;
 
          /* initialize the tapeinput with u_bar only at C-points */
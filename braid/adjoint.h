@@ -44,6 +44,17 @@ braid_Int
 _braid_VectorBarCopy(braid_VectorBar  bar,       
                      braid_VectorBar *bar_ptr);  
 
+/**
+ * Allocate the user vector of a lazily created bar vector and set it to zero,
+ * if it is not allocated yet.  A bar without a user vector (userVector is
+ * NULL) represents zero.  Uses the user's InitZero routine if set, otherwise
+ * Init followed by Sum.
+ */
+braid_Int
+_braid_VectorBarInit(braid_Core      core,
+                     braid_Real      t,
+                     braid_VectorBar bar);
+
 /**
  * Reduce the useCount of a braid_VectorBar shared pointer 
  * Free the pointer memory if useCount is zero.  
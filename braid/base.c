@@ -26,6 +26,242 @@
 #include "_braid.h"
 #include "util.h"
 
+/*----------------------------------------------------------------------------
+ * The braid_BaseVector and braid_VectorBar structs are small and allocated
+ * very often, so they come from a core-owned slab of fixed-size cells.  Cells
+ * are carved out of chunks of _braid_SlabChunk and reused through a free list.
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_SlabAlloc(braid_Core   core,
+                 void       **cell_ptr)
+{
+   _braid_SlabCell  *chunk, *cell;
+   braid_Int         nchunks = _braid_CoreElt(core, slab_nchunks);
+   braid_Int         i;
+
+   if (_braid_CoreElt(core, slab_free) == NULL)
+   {
+      chunk = _braid_TAlloc(_braid_SlabCell, _braid_SlabChunk);
+      for (i = 0; i < _braid_SlabChunk-1; i++)
+      {
+         chunk[i].next = &chunk[i+1];
+      }
+      chunk[_braid_SlabChunk-1].next = NULL;
+
+      _braid_CoreElt(core, slab_chunks) =
+         _braid_TReAlloc(_braid_CoreElt(core, slab_chunks), _braid_SlabCell *, nchunks+1);
+      _braid_CoreElt(core, slab_chunks)[nchunks] = chunk;
+      _braid_CoreElt(core, slab_nchunks) = nchunks+1;
+      _braid_CoreElt(core, slab_free)    = chunk;
+   }
+
+   cell = _braid_CoreElt(core, slab_free);
+   _braid_CoreElt(core, slab_free) = cell->next;
+
+   _braid_CoreElt(core, slab_used) ++;
+   if (_braid_CoreElt(core, slab_used) > _braid_CoreElt(core, slab_peak))
+   {
+      _braid_CoreElt(core, slab_peak) = _braid_CoreElt(core, slab_used);
+   }
+
+   *cell_ptr = (void *) cell;
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_SlabFree(braid_Core   core,
+                void        *cell_ptr)
+{
+   _braid_SlabCell  *cell = (_braid_SlabCell *) cell_ptr;
+
+   cell->next = _braid_CoreElt(core, slab_free);
+   _braid_CoreElt(core, slab_free) = cell;
+   _braid_CoreElt(core, slab_used) --;
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_SlabDestroy(braid_Core  core)
+{
+   braid_Int  i;
+
+   for (i = 0; i < _braid_CoreElt(core, slab_nchunks); i++)
+   {
+      _braid_TFree(_braid_CoreElt(core, slab_chunks)[i]);
+   }
+   _braid_TFree(_braid_CoreElt(core, slab_chunks));
+   _braid_CoreElt(core, slab_nchunks) = 0;
+   _braid_CoreElt(core, slab_free)    = NULL;
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ *----------------------------------------------------------------------------*/
+
+/*----------------------------------------------------------------------------
+ * The level that user callbacks are charged to is kept per thread, since one
+ * thread may coarsen to level+1 while the others still relax on level.
+ *----------------------------------------------------------------------------*/
+
+static braid_Int _braid_call_level = 0;
+#ifdef _OPENMP
+#pragma omp threadprivate(_braid_call_level)
+#endif
+
+braid_Int
+_braid_SetCallLevel(braid_Int   level,
+                    braid_Int  *old_level_ptr)
+{
+   if (old_level_ptr != NULL)
+   {
+      *old_level_ptr = _braid_call_level;
+   }
+   _braid_call_level = level;
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_CountCall(braid_Core  core,
+                 braid_Int   call)
+{
+   braid_Int  level = _braid_call_level;
+
+   if (_braid_CoreElt(core, ncalls) != NULL)
+   {
+      /* Steps and sums may be counted from several threads (see thread.c) */
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+      _braid_CoreElt(core, ncalls)[level*braid_NCalls+call] += 1.0;
+   }
+
+   /* The live vector counts are updated together, so they need their own
+    * critical section (this may already be inside a _braid_Critical one) */
+#ifdef _OPENMP
+#pragma omp critical (braid_live)
+#endif
+   {
+      switch (call)
+      {
+         case braid_Call_Init:
+         case braid_Call_Clone:
+         case braid_Call_BufUnpack:
+         case braid_Call_SCoarsen:
+         case braid_Call_SRefine:
+            _braid_CoreElt(core, nlive)++;
+            _braid_CoreElt(core, nlive_peak) =
+               _braid_max(_braid_CoreElt(core, nlive_peak), _braid_CoreElt(core, nlive));
+            break;
+         case braid_Call_Free:
+            _braid_CoreElt(core, nlive)--;
+            break;
+      }
+   }
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ * Freed vectors are recycled if the user provides a copy routine.  This is
+ * not done for adjoint runs (bar vectors and the tape) or shell vectors (a
+ * freed vector may be only a shell).  With spatial coarsening, vector sizes
+ * differ by level, so the buffer view is needed to tell them apart.
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_BasePoolOn(braid_Core  core)
+{
+   return ( (_braid_CoreElt(core, copy) != NULL) &&
+            (_braid_CoreElt(core, vpool_max) > 0) &&
+            !_braid_CoreElt(core, adjoint) &&
+            !_braid_CoreElt(core, useshell) &&
+            ( (_braid_CoreElt(core, scoarsen) == NULL) ||
+              (_braid_CoreElt(core, bufview) != NULL) ) );
+}
+
+/*----------------------------------------------------------------------------
+ * Pooled vectors are keyed by their size in bytes, so a vector is only
+ * recycled for one of the same spatial level.  Without spatial coarsening,
+ * all vectors have the same size and the key is 0.
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_BasePoolKey(braid_Core        core,
+                   braid_BaseVector  u)
+{
+   void       *data;
+   braid_Int   size = 0;
+
+   if (_braid_CoreElt(core, scoarsen) != NULL)
+   {
+      _braid_BaseBufView(core, _braid_CoreElt(core, app), u, &data, &size);
+   }
+
+   return size;
+}
+
+/*----------------------------------------------------------------------------
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_BasePoolGet(braid_Core         core,
+                   braid_Int          key,
+                   braid_BaseVector  *v_ptr)
+{
+   braid_BaseVector  *vpool      = _braid_CoreElt(core, vpool);
+   braid_Int         *vpool_keys = _braid_CoreElt(core, vpool_keys);
+   braid_Int          last       = _braid_CoreElt(core, vpool_size) - 1;
+   braid_Int          i;
+
+   *v_ptr = NULL;
+   for (i = last; i >= 0; i--)
+   {
+      if (vpool_keys[i] == key)
+      {
+         *v_ptr        = vpool[i];
+         vpool[i]      = vpool[last];
+         vpool_keys[i] = vpool_keys[last];
+         _braid_CoreElt(core, vpool_size) --;
+         break;
+      }
+   }
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_BasePoolDestroy(braid_Core  core,
+                       braid_App   app)
+{
+   braid_BaseVector  u;
+
+   while (_braid_CoreElt(core, vpool_size) > 0)
+   {
+      u = _braid_CoreElt(core, vpool)[--_braid_CoreElt(core, vpool_size)];
+      _braid_CountFcn(core, free)(app, u->userVector);
+      _braid_SlabFree(core, u);
+   }
+
+   return _braid_error_flag;
+}
+
 /*----------------------------------------------------------------------------
  *----------------------------------------------------------------------------*/
 
@@ -44,13 +280,13 @@ _braid_BaseStep(braid_Core       core,
    braid_Int        myid        = _braid_CoreElt(core, myid);
    braid_Int        verbose_adj = _braid_CoreElt(core, verbose_adj);
    braid_Int        record      = _braid_CoreElt(core, record);
-   braid_Real       t           = _braid_CoreElt(core, t);
-   braid_Real       tnext       = _braid_CoreElt(core, tnext);
-   braid_Int        tidx        = _braid_CoreElt(core, idx);
-   braid_Int        iter        = _braid_CoreElt(core, niter);
-   braid_Int        nrefine     = _braid_CoreElt(core, nrefine);
-   braid_Int        gupper      = _braid_CoreElt(core, gupper);
-   braid_Real       tol         = _braid_CoreElt(core, tol);
+   braid_Real       t           = _braid_StatusElt(status, t);
+   braid_Real       tnext       = _braid_StatusElt(status, tnext);
+   braid_Int        tidx        = _braid_StatusElt(status, idx);
+   braid_Int        iter        = _braid_StatusElt(status, niter);
+   braid_Int        nrefine     = _braid_StatusElt(status, nrefine);
+   braid_Int        gupper      = _braid_StatusElt(status, gupper);
+   braid_Real       tol         = _braid_StatusElt(status, tol);
 
    if (verbose_adj) printf("%d: STEP %.4f to %.4f, %d\n", myid, t, tnext, tidx);
 
@@ -73,8 +309,8 @@ _braid_BaseStep(braid_Core       core,
       _braid_CoreElt(core, actionTape) = _braid_TapePush( _braid_CoreElt(core, actionTape) , action);
 
       /* Copy & push u & ustop to primal tape */
-      _braid_CoreFcn(core, clone)(app, u->userVector, &u_copy); 
-      _braid_CoreFcn(core, clone)(app, ustop->userVector, &ustop_copy);  
+      _braid_CountFcn(core, clone)(app, u->userVector, &u_copy); 
+      _braid_CountFcn(core, clone)(app, ustop->userVector, &ustop_copy);  
       _braid_CoreElt(core, userVectorTape) = _braid_TapePush( _braid_CoreElt(core, userVectorTape), u_copy);
       _braid_CoreElt(core, userVectorTape) = _braid_TapePush( _braid_CoreElt(core, userVectorTape), ustop_copy);
 
@@ -85,20 +321,26 @@ _braid_BaseStep(braid_Core       core,
       _braid_CoreElt(core, barTape) = _braid_TapePush(_braid_CoreElt(core, barTape), ustopbar_copy);
   }
 
+   /* Let a zero-copy send that is still reading u keep its data */
+   if (u->send != NULL)
+   {
+      _braid_CommRelease(core, u, 1);
+   }
+
    /* Call the users Step function.  If periodic and integrating to the periodic
     * point, adjust tnext to be tstop. */
-   if ( _braid_CoreElt(core, periodic) && (_braid_CoreElt(core, idx) < 0) )
+   if ( _braid_CoreElt(core, periodic) && (tidx < 0) )
    {
-      _braid_CoreElt(core, tnext) = _braid_CoreElt(core, tstop);
+      _braid_StatusElt(status, tnext) = _braid_CoreElt(core, tstop);
    }
    if ( fstop == NULL )
    {
-      _braid_CoreFcn(core, step)(app, ustop->userVector, NULL, u->userVector, status);
+      _braid_CountFcn(core, step)(app, ustop->userVector, NULL, u->userVector, status);
    }
    else
    {
       /* fstop not supported by adjoint! */
-      _braid_CoreFcn(core, step)(app, ustop->userVector, fstop->userVector, u->userVector, status);
+      _braid_CountFcn(core, step)(app, ustop->userVector, fstop->userVector, u->userVector, status);
    }
 
    return _braid_error_flag;
@@ -124,20 +366,20 @@ _braid_BaseInit(braid_Core        core,
    if (verbose_adj) printf("%d INIT\n", myid);
 
    /* Allocate the braid_BaseVector */
-   u = (braid_BaseVector) malloc(sizeof(braid_Vector) + sizeof(braid_VectorBar));
+   _braid_SlabAlloc(core, (void **) &u);
    u->userVector = NULL;
    u->bar        = NULL;
+   u->send       = NULL;
 
    /* Allocate and initialize the userVector */
-   _braid_CoreFcn(core, init)(app, t, &(u->userVector));
+   _braid_CountFcn(core, init)(app, t, &(u->userVector));
    
-   /* Allocate and initialize the bar vector */
+   /* Allocate the bar vector, its user vector is created on first write */
    if ( adjoint ) 
    {
-      ubar = (braid_VectorBar) malloc(sizeof(braid_Vector) + sizeof(int));
-      ubar->useCount = 1;
-      _braid_CoreFcn(core, init)(app, t, &(ubar->userVector));
-      _braid_CoreFcn(core, sum)(app, -1.0, ubar->userVector, 1.0, ubar->userVector);
+      _braid_SlabAlloc(core, (void **) &ubar);
+      ubar->useCount   = 1;
+      ubar->userVector = NULL;
       u->bar = ubar;
    }
 
@@ -180,21 +422,34 @@ _braid_BaseClone(braid_Core         core,
 
    if (verbose_adj) printf("%d: CLONE\n", myid);
 
+   /* Copy into a recycled vector of the same size if there is one */
+   if ( _braid_BasePoolOn(core) && (_braid_CoreElt(core, vpool_size) > 0) )
+   {
+      _braid_BasePoolGet(core, _braid_BasePoolKey(core, u), &v);
+      if (v != NULL)
+      {
+         _braid_BaseCopy(core, app, u, v);
+         *v_ptr = v;
+
+         return _braid_error_flag;
+      }
+   }
+
    /* Allocate the braid_BaseVector */
-   v = (braid_BaseVector) malloc(sizeof(braid_Vector) + sizeof(braid_VectorBar));
+   _braid_SlabAlloc(core, (void **) &v);
    v->userVector  = NULL;
    v->bar = NULL;
+   v->send = NULL;
 
    /* Allocate and copy the userVector */
-   _braid_CoreFcn(core, clone)(app, u->userVector, &(v->userVector) );
+   _braid_CountFcn(core, clone)(app, u->userVector, &(v->userVector) );
 
-   /* Allocate and initialize the bar vector to zero*/
+   /* Allocate the bar vector, its user vector is created on first write */
    if ( adjoint )
    {
-      ubar = (braid_VectorBar) malloc(sizeof(braid_Vector) + sizeof(int));
-      ubar->useCount = 1;
-      _braid_CoreFcn(core, clone)(app, u->bar->userVector, &(ubar->userVector));
-      _braid_CoreFcn(core, sum)(app, -1.0, ubar->userVector, 1.0, ubar->userVector);
+      _braid_SlabAlloc(core, (void **) &ubar);
+      ubar->useCount   = 1;
+      ubar->userVector = NULL;
       v->bar = ubar;
    } 
 
@@ -221,6 +476,28 @@ _braid_BaseClone(braid_Core         core,
    return _braid_error_flag;
 }
 
+/*----------------------------------------------------------------------------
+ * Copies u into the existing vector v through the user's copy routine.  This
+ * is not recorded, so it is only used when the adjoint is off.
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_BaseCopy(braid_Core         core,
+                braid_App          app,
+                braid_BaseVector   u,
+                braid_BaseVector   v )
+{
+   /* Let a zero-copy send that is still reading v keep its data */
+   if (v->send != NULL)
+   {
+      _braid_CommRelease(core, v, 1);
+   }
+
+   _braid_CountFcn(core, copy)(app, u->userVector, v->userVector);
+
+   return _braid_error_flag;
+}
+
 /*----------------------------------------------------------------------------
  *----------------------------------------------------------------------------*/
 
@@ -248,9 +525,31 @@ _braid_BaseFree(braid_Core       core,
       action->myid      = myid;
       _braid_CoreElt(core, actionTape) = _braid_TapePush( _braid_CoreElt(core, actionTape) , action);
    }
+
+   /* Let a zero-copy send that is still reading u take over its data */
+   if (u->send != NULL)
+   {
+      _braid_CommRelease(core, u, 0);
+   }
+   if (u->userVector == NULL)
+   {
+      _braid_SlabFree(core, u);
+
+      return _braid_error_flag;
+   }
+
+   /* Keep the vector for a later clone if there is room in the pool */
+   if ( _braid_BasePoolOn(core) &&
+        (_braid_CoreElt(core, vpool_size) < _braid_CoreElt(core, vpool_max)) )
+   {
+      _braid_CoreElt(core, vpool_keys)[_braid_CoreElt(core, vpool_size)] = _braid_BasePoolKey(core, u);
+      _braid_CoreElt(core, vpool)[_braid_CoreElt(core, vpool_size)++]    = u;
+
+      return _braid_error_flag;
+   }
  
    /* Free the user's vector */
-   _braid_CoreFcn(core, free)(app, u->userVector);
+   _braid_CountFcn(core, free)(app, u->userVector);
 
    if ( adjoint )
    {
@@ -259,7 +558,7 @@ _braid_BaseFree(braid_Core       core,
    }
 
    /* Free the braid_BaseVector */
-   free(u);
+   _braid_SlabFree(core, u);
 
    return _braid_error_flag;
 }
@@ -303,8 +602,14 @@ _braid_BaseSum(braid_Core        core,
       _braid_CoreElt(core, barTape) = _braid_TapePush(_braid_CoreElt(core, barTape), ybar_copy);
    }
 
+   /* Let a zero-copy send that is still reading y keep its data */
+   if (y->send != NULL)
+   {
+      _braid_CommRelease(core, y, 1);
+   }
+
     /* Sum up the user's vector */
-   _braid_CoreFcn(core, sum)(app, alpha, x->userVector, beta, y->userVector);
+   _braid_CountFcn(core, sum)(app, alpha, x->userVector, beta, y->userVector);
 
    return _braid_error_flag;
 }
@@ -319,7 +624,7 @@ _braid_BaseSpatialNorm(braid_Core        core,
                        braid_Real       *norm_ptr )
 {
    /* Compute the spatial norm of the user's vector */
-   _braid_CoreFcn(core, spatialnorm)(app, u->userVector, norm_ptr);
+   _braid_CountFcn(core, spatialnorm)(app, u->userVector, norm_ptr);
 
    return _braid_error_flag;
 }
@@ -334,7 +639,7 @@ _braid_BaseAccess(braid_Core          core,
                   braid_AccessStatus  status )
 {
    _braid_Action   *action;
-   braid_Real       t             = _braid_CoreElt(core, t);
+   braid_Real       t             = _braid_StatusElt(status, t);
    braid_Int        myid          = _braid_CoreElt(core, myid);
    braid_Int        verbose_adj   = _braid_CoreElt(core, verbose_adj);
    braid_Int        record        = _braid_CoreElt(core, record);
@@ -414,7 +719,7 @@ _braid_BaseBufPack(braid_Core          core,
    braid_Int        myid         = _braid_CoreElt(core, myid);
    braid_Int        verbose_adj  = _braid_CoreElt(core, verbose_adj);
    braid_Int        record       = _braid_CoreElt(core, record);
-   braid_Int        sender       = _braid_CoreElt(core, send_recv_rank);
+   braid_Int        sender       = _braid_StatusElt(status, send_recv_rank);
 
    if ( verbose_adj ) printf("%d: BUFPACK\n",  myid );
 
@@ -437,7 +742,7 @@ _braid_BaseBufPack(braid_Core          core,
    }
    
    /* BufPack the user's vector */
-   _braid_CoreFcn(core, bufpack)(app, u->userVector, buffer, status);
+   _braid_CountFcn(core, bufpack)(app, u->userVector, buffer, status);
 
    return _braid_error_flag;
 }
@@ -460,26 +765,25 @@ _braid_BaseBufUnpack(braid_Core          core,
    braid_Int        verbose_adj  = _braid_CoreElt(core, verbose_adj);
    braid_Int        adjoint      = _braid_CoreElt(core, adjoint);
    braid_Int        record       = _braid_CoreElt(core, record);
-   braid_Int        receiver     = _braid_CoreElt(core, send_recv_rank);
-   braid_Real       tstart       = _braid_CoreElt(core, tstart);
+   braid_Int        receiver     = _braid_StatusElt(status, send_recv_rank);
 
    if ( verbose_adj ) printf("%d: BUFUNPACK\n", myid);
 
    /* Allocate the braid_BaseVector */
-   u = (braid_BaseVector) malloc(sizeof(braid_Vector) + sizeof(braid_VectorBar));
+   _braid_SlabAlloc(core, (void **) &u);
    u->userVector  = NULL;
    u->bar = NULL;
+   u->send = NULL;
 
    /* BufUnpack the user's vector */
-   _braid_CoreFcn(core, bufunpack)(app, buffer, &(u->userVector), status);
+   _braid_CountFcn(core, bufunpack)(app, buffer, &(u->userVector), status);
 
    if ( adjoint )
    {
-      /* Allocate and initialize the bar vector with zero*/
-      ubar = (braid_VectorBar) malloc(sizeof(braid_Vector) + sizeof(int));
-      ubar->useCount = 1;
-      _braid_CoreFcn(core, init)(app, tstart, &(ubar->userVector));
-      _braid_CoreFcn(core, sum)(app, -1.0, ubar->userVector, 1.0, ubar->userVector);
+      /* Allocate the bar vector, its user vector is created on first write */
+      _braid_SlabAlloc(core, (void **) &ubar);
+      ubar->useCount   = 1;
+      ubar->userVector = NULL;
       u->bar = ubar;
    }
 
@@ -506,6 +810,27 @@ _braid_BaseBufUnpack(braid_Core          core,
    return _braid_error_flag;
 }
 
+/*----------------------------------------------------------------------------
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_BaseBufView(braid_Core          core,
+                   braid_App           app,
+                   braid_BaseVector    u,
+                   void              **data_ptr,
+                   braid_Int          *size_ptr )
+{
+   braid_Int  myid         = _braid_CoreElt(core, myid);
+   braid_Int  verbose_adj  = _braid_CoreElt(core, verbose_adj);
+
+   if ( verbose_adj ) printf("%d: BUFVIEW\n", myid);
+
+   /* Call the users BufView function */
+   _braid_CoreFcn(core, bufview)(app, u->userVector, data_ptr, size_ptr);
+
+   return _braid_error_flag;
+}
+
 /*----------------------------------------------------------------------------
  *----------------------------------------------------------------------------*/
 
@@ -522,12 +847,12 @@ _braid_BaseObjectiveT(braid_Core             core,
    braid_Int        verbose_adj   = _braid_CoreElt(core, verbose_adj);
    braid_Int        record        = _braid_CoreElt(core, record);
    braid_Int        myid          = _braid_CoreElt(core, myid);
-   braid_Real       t             = _braid_CoreElt(core, t);
-   braid_Int        idx           = _braid_CoreElt(core, idx);
-   braid_Int        iter          = _braid_CoreElt(core, niter);
-   braid_Int        level         = _braid_CoreElt(core, level);
-   braid_Int        nrefine       = _braid_CoreElt(core, nrefine);
-   braid_Int        gupper        = _braid_CoreElt(core, gupper);
+   braid_Real       t             = _braid_StatusElt(ostatus, t);
+   braid_Int        idx           = _braid_StatusElt(ostatus, idx);
+   braid_Int        iter          = _braid_StatusElt(ostatus, niter);
+   braid_Int        level         = _braid_StatusElt(ostatus, level);
+   braid_Int        nrefine       = _braid_StatusElt(ostatus, nrefine);
+   braid_Int        gupper        = _braid_StatusElt(ostatus, gupper);
    
    if ( verbose_adj ) printf("%d: OBJECTIVET\n", myid);
 
@@ -548,7 +873,7 @@ _braid_BaseObjectiveT(braid_Core             core,
       _braid_CoreElt(core, actionTape) = _braid_TapePush( _braid_CoreElt(core, actionTape) , action);
 
       /* Push a copy of the user's vector to the userVector tape */
-      _braid_CoreFcn(core, clone)(app, u->userVector, &u_copy);     // this will accolate memory for the copy!
+      _braid_CountFcn(core, clone)(app, u->userVector, &u_copy);     // this will accolate memory for the copy!
       _braid_CoreElt(core, userVectorTape) = _braid_TapePush( _braid_CoreElt(core, userVectorTape), u_copy);
 
       /* Push a copy of the bar vector to the bar tape */
@@ -577,6 +902,12 @@ _braid_BaseResidual(braid_Core        core,
 
    if ( verbose_adj ) printf("%d: RESIDUAL\n", myid);
 
+   /* Let a zero-copy send that is still reading r keep its data */
+   if (r->send != NULL)
+   {
+      _braid_CommRelease(core, r, 1);
+   }
+
    /* Call the users Residual function */
    _braid_CoreFcn(core, residual)(app, ustop->userVector, r->userVector, status);
 
@@ -598,6 +929,12 @@ _braid_BaseFullResidual(braid_Core        core,
 
    if ( verbose_adj ) printf("%d: FULLRESIDUAL\n", myid);
 
+   /* Let a zero-copy send that is still reading u keep its data */
+   if (u->send != NULL)
+   {
+      _braid_CommRelease(core, u, 1);
+   }
+
    /* Call the users Residual function */
    _braid_CoreFcn(core, full_rnorm_res)(app, r->userVector, u->userVector, status);
 
@@ -620,10 +957,12 @@ _braid_BaseSCoarsen(braid_Core              core,
 
    if ( verbose_adj ) printf("%d: SCOARSEN\n", myid);
 
-   cu = (braid_BaseVector) malloc(sizeof(braid_BaseVector));
+   _braid_SlabAlloc(core, (void **) &cu);
+   cu->bar = NULL;
+   cu->send = NULL;
 
    /* Call the users SCoarsen Function */
-   _braid_CoreFcn(core, scoarsen)(app, fu->userVector, &(cu->userVector), status);
+   _braid_CountFcn(core, scoarsen)(app, fu->userVector, &(cu->userVector), status);
 
    *cu_ptr = cu;
 
@@ -646,10 +985,12 @@ _braid_BaseSRefine(braid_Core                 core,
 
    if ( verbose_adj ) printf("%d: SREFINE\n", myid);
 
-   fu = (braid_BaseVector) malloc(sizeof(braid_BaseVector));
+   _braid_SlabAlloc(core, (void **) &fu);
+   fu->bar = NULL;
+   fu->send = NULL;
 
    /* Call the users SRefine */
-   _braid_CoreFcn(core, srefine)(app, cu->userVector, &(fu->userVector), status);
+   _braid_CountFcn(core, srefine)(app, cu->userVector, &(fu->userVector), status);
 
    *fu_ptr = fu;
 
@@ -671,10 +1012,12 @@ _braid_BaseSInit(braid_Core        core,
 
    if ( verbose_adj ) printf("%d: SINIT\n", myid);
 
-   u = (braid_BaseVector) malloc(sizeof(braid_BaseVector));
+   _braid_SlabAlloc(core, (void **) &u);
+   u->bar = NULL;
+   u->send = NULL;
 
    /* Call the users SInit */
-   _braid_CoreFcn(core, sinit)(app, t, &(u->userVector));
+   _braid_CountFcn(core, sinit)(app, t, &(u->userVector));
 
    *u_ptr = u;
 
@@ -697,10 +1040,12 @@ _braid_BaseSClone(braid_Core        core,
 
    if ( verbose_adj ) printf("%d: SCLONE\n", myid);
 
-   v = (braid_BaseVector) malloc(sizeof(braid_BaseVector));
+   _braid_SlabAlloc(core, (void **) &v);
+   v->bar = NULL;
+   v->send = NULL;
 
    /* Call the users SClone */
-   _braid_CoreFcn(core, sclone)(app, u->userVector, &(v->userVector));
+   _braid_CountFcn(core, sclone)(app, u->userVector, &(v->userVector));
 
    *v_ptr = v;
 
@@ -721,6 +1066,12 @@ _braid_BaseSFree(braid_Core      core,
  
    if ( verbose_adj ) printf("%d: SFREE\n", myid);
 
+   /* Let a zero-copy send that is still reading u keep its data */
+   if (u->send != NULL)
+   {
+      _braid_CommRelease(core, u, 1);
+   }
+
    /* Call the users sfree */
    _braid_CoreFcn(core, sfree)(app, u->userVector);
 
@@ -757,7 +1108,8 @@ _braid_BaseStep_diff(_braid_Action *action)
    braid_Vector     u, ustop;
    braid_VectorBar  ubar, ustopbar;
    braid_Core       core         = action->core;
-   braid_StepStatus status       = (braid_StepStatus) action->core;
+   _braid_StepStatus status_s;
+   braid_StepStatus  status      = &status_s;
    braid_Real       inTime       = action->inTime;
    braid_Real       outTime      = action->outTime;
    braid_Int        tidx         = action->inTimeIdx;
@@ -770,6 +1122,8 @@ _braid_BaseStep_diff(_braid_Action *action)
    braid_Int        verbose_adj  = _braid_CoreElt(core, verbose_adj);
    braid_Int        myid         = _braid_CoreElt(core, myid);
 
+   _braid_StatusInit(core, (braid_Status) status);
+
    if ( verbose_adj ) printf("%d: STEP_DIFF %.4f to %.4f, %d\n", myid, inTime, outTime, tidx);
 
    /* Pop ustop & u from primal tape */
@@ -785,17 +1139,22 @@ _braid_BaseStep_diff(_braid_Action *action)
    _braid_CoreElt(core, barTape) = _braid_TapePop( _braid_CoreElt(core, barTape) );
 
 
+   /* The user's routine reads and writes both bar vectors */
+   _braid_VectorBarInit(core, inTime, ubar);
+   _braid_VectorBarInit(core, outTime, ustopbar);
+
    /* Set up the status structure */
    _braid_StepStatusInit(inTime, outTime, tidx, tol, iter, level, nrefine, gupper, status);
 
    /* Call the users's differentiated step function */
    _braid_CoreFcn(core, step_diff)(app, ustop, u, ustopbar->userVector, ubar->userVector, status);
+   _braid_StepStatusDone(status);
 
    /* Free memory of the primal and bar vectors */
    _braid_VectorBarDelete(core, ubar);
    _braid_VectorBarDelete(core, ustopbar);
-   _braid_CoreFcn(core, free)(app, u);
-   _braid_CoreFcn(core, free)(app, ustop);
+   _braid_CountFcn(core, free)(app, u);
+   _braid_CountFcn(core, free)(app, ustop);
 
    return _braid_error_flag;
 }
@@ -826,8 +1185,21 @@ _braid_BaseClone_diff(_braid_Action *action)
    *  ub += vb
    *  vb  = 0.0
    */
-   _braid_CoreFcn(core, sum)(_braid_CoreElt(core,app),1.0, v_bar->userVector,  1.0, u_bar->userVector);
-   _braid_CoreFcn(core, sum)(_braid_CoreElt(core,app),1.0, v_bar->userVector, -1.0, v_bar->userVector);
+   if (v_bar->userVector == NULL)
+   {
+      /* vbar is zero, nothing to add */
+   }
+   else if (u_bar->userVector == NULL)
+   {
+      /* ubar is zero, so hand the vbar data over instead of adding it */
+      u_bar->userVector = v_bar->userVector;
+      v_bar->userVector = NULL;
+   }
+   else
+   {
+      _braid_CountFcn(core, sum)(_braid_CoreElt(core,app),1.0, v_bar->userVector,  1.0, u_bar->userVector);
+      _braid_CountFcn(core, sum)(_braid_CoreElt(core,app),1.0, v_bar->userVector, -1.0, v_bar->userVector);
+   }
 
    /* Free the bar vectors */
    _braid_VectorBarDelete(core, u_bar);
@@ -865,8 +1237,48 @@ _braid_BaseSum_diff(_braid_Action *action)
    *  xb += alpha * yb
    *  yb  = beta  * yb
    */
-   _braid_CoreFcn(core, sum)(app, alpha, y_bar->userVector,  1.0, x_bar->userVector);
-   _braid_CoreFcn(core, sum)(app,   0.0, x_bar->userVector, beta, y_bar->userVector);
+   if (y_bar->userVector == NULL)
+   {
+      /* yb is zero, so neither xb nor yb changes */
+   }
+   else
+   {
+      if (alpha != 0.0)
+      {
+         if (x_bar->userVector == NULL)
+         {
+            /* xb is zero, so xb = alpha * yb (hand the data over if yb is zeroed anyway) */
+            if (beta == 0.0)
+            {
+               x_bar->userVector = y_bar->userVector;
+               y_bar->userVector = NULL;
+            }
+            else
+            {
+               _braid_CountFcn(core, clone)(app, y_bar->userVector, &(x_bar->userVector));
+            }
+            if (alpha != 1.0)
+            {
+               _braid_CountFcn(core, sum)(app, 0.0, x_bar->userVector, alpha, x_bar->userVector);
+            }
+         }
+         else
+         {
+            _braid_CountFcn(core, sum)(app, alpha, y_bar->userVector,  1.0, x_bar->userVector);
+         }
+      }
+
+      if (y_bar->userVector != NULL && beta == 0.0)
+      {
+         /* yb becomes zero, release its data */
+         _braid_CountFcn(core, free)(app, y_bar->userVector);
+         y_bar->userVector = NULL;
+      }
+      else if (y_bar->userVector != NULL && beta != 1.0)
+      {
+         _braid_CountFcn(core, sum)(app, 0.0, y_bar->userVector, beta, y_bar->userVector);
+      }
+   }
 
    /* Free the bar vectors */
    _braid_VectorBarDelete(core, y_bar);
@@ -894,7 +1306,10 @@ _braid_BaseObjectiveT_diff(_braid_Action *action)
    braid_App              app          = _braid_CoreElt(core, app);
    braid_Int              verbose_adj  = _braid_CoreElt(core, verbose_adj);
    braid_Real             f_bar        = _braid_CoreElt(core, optim)->f_bar;
-   braid_ObjectiveStatus  ostatus      = (braid_ObjectiveStatus) action->core;
+   _braid_ObjectiveStatus ostatus_s;
+   braid_ObjectiveStatus  ostatus      = &ostatus_s;
+
+   _braid_StatusInit(core, (braid_Status) ostatus);
 
    if ( verbose_adj ) printf("%d: OBJT_DIFF\n", myid);
 
@@ -906,22 +1321,32 @@ _braid_BaseObjectiveT_diff(_braid_Action *action)
    _braid_CoreElt(core, userVectorTape) = _braid_TapePop( _braid_CoreElt(core, userVectorTape) );
    _braid_CoreElt(core, barTape)        = _braid_TapePop( _braid_CoreElt(core, barTape) );
 
-   /* Store the values of the adjoint */
-   braid_Vector userbarCopy;
-   _braid_CoreFcn(core, clone)(app, ubar->userVector, &userbarCopy);
+   /* Store the values of the adjoint (nothing to store if ubar is still zero) */
+   braid_Vector userbarCopy = NULL;
+   if (ubar->userVector != NULL)
+   {
+      _braid_CountFcn(core, clone)(app, ubar->userVector, &userbarCopy);
+   }
+   else
+   {
+      _braid_VectorBarInit(core, t, ubar);
+   }
 
   /* Call the users's differentiated objective function */
    _braid_ObjectiveStatusInit(t, idx, iter, level, nrefine, gupper, ostatus);
    _braid_CoreFcn(core, objT_diff)( app, u, ubar->userVector, f_bar, ostatus);
 
-   /* Add the stored value */
-   _braid_CoreFcn(core, sum)(app, 1., userbarCopy, 1., ubar->userVector);
+   if (userbarCopy != NULL)
+   {
+      /* Add the stored value */
+      _braid_CountFcn(core, sum)(app, 1., userbarCopy, 1., ubar->userVector);
 
-   /* Free the stores value */
-   _braid_CoreFcn(core, free)(app, userbarCopy);
+      /* Free the stores value */
+      _braid_CountFcn(core, free)(app, userbarCopy);
+   }
 
    /* Free primal and bar vectors */
-   _braid_CoreFcn(core, free)(app, u);
+   _braid_CountFcn(core, free)(app, u);
    _braid_VectorBarDelete(core, ubar);
 
    return _braid_error_flag;
@@ -944,7 +1369,10 @@ _braid_BaseBufPack_diff(_braid_Action *action )
    braid_App          app             = _braid_CoreElt(core, app);
    braid_Int          verbose_adj     = _braid_CoreElt(core, verbose_adj);
    braid_Int          myid            = _braid_CoreElt(core, myid);
-   braid_BufferStatus bstatus         = (braid_BufferStatus) core;
+   _braid_BufferStatus bstatus_s;
+   braid_BufferStatus  bstatus        = &bstatus_s;
+
+   _braid_StatusInit(core, (braid_Status) bstatus);
 
    if ( verbose_adj ) printf("%d: BUFPACK_DIFF\n", myid);
 
@@ -963,14 +1391,21 @@ _braid_BaseBufPack_diff(_braid_Action *action )
    _braid_BufferStatusInit( messagetype, size_buffer, bstatus);
 
    /* Unpack the buffer into u */
-   _braid_CoreFcn(core, bufunpack)(app, buffer, &u, bstatus);
+   _braid_CountFcn(core, bufunpack)(app, buffer, &u, bstatus);
 
-   /* Update ubar with u */
-   _braid_CoreFcn(core, sum)( app, 1., u, 1., ubar->userVector);
+   /* Update ubar with u (ubar takes over u, if it is still zero) */
+   if (ubar->userVector == NULL)
+   {
+      ubar->userVector = u;
+   }
+   else
+   {
+      _braid_CountFcn(core, sum)( app, 1., u, 1., ubar->userVector);
+      _braid_CountFcn(core, free)(app, u);
+   }
 
    /* Free the vectors */
    _braid_VectorBarDelete(core, ubar);
-   _braid_CoreFcn(core, free)(app, u);
    free(buffer);
 
    return _braid_error_flag;
@@ -990,11 +1425,14 @@ _braid_BaseBufUnpack_diff(_braid_Action *action)
    braid_Real          send_recv_rank = action->send_recv_rank;
    braid_Int           messagetype    = action->messagetype;
    braid_Int           size_buffer    = action->size_buffer;
-   braid_BufferStatus  bstatus        = (braid_BufferStatus) core;
+   _braid_BufferStatus bstatus_s;
+   braid_BufferStatus  bstatus        = &bstatus_s;
    braid_App           app            = _braid_CoreElt(core, app);
    braid_Int           verbose_adj    = _braid_CoreElt(core, verbose_adj);
    braid_Int           myid           = _braid_CoreElt(core, myid);
 
+   _braid_StatusInit(core, (braid_Status) bstatus);
+
    if ( verbose_adj ) printf("%d: BUFUNPACK_DIFF\n", myid);
 
    /* Get the bar vector and pop it from the tape*/
@@ -1015,9 +1453,10 @@ _braid_BaseBufUnpack_diff(_braid_Action *action)
    /* Initialize the bufferstatus */
    _braid_BufferStatusInit( messagetype, size_buffer, bstatus);
 
-   /* Pack the buffer */
+   /* Pack the buffer (a zero ubar needs a vector to pack) */
+   _braid_VectorBarInit(core, _braid_CoreElt(core, tstart), ubar);
    sendbuffer = _braid_CoreElt(core, optim)->sendbuffer;
-   _braid_CoreFcn(core, bufpack)( app, ubar->userVector, sendbuffer, bstatus);
+   _braid_CountFcn(core, bufpack)( app, ubar->userVector, sendbuffer, bstatus);
 
    /* Send the buffer  */
    requests = _braid_CTAlloc(MPI_Request, 1);
@@ -1027,7 +1466,8 @@ _braid_BaseBufUnpack_diff(_braid_Action *action)
    _braid_CoreElt(core, optim)->request = requests;
    
    /* Set ubar to zero */
-   _braid_CoreFcn(core, sum)(app, -1., ubar->userVector, 1., ubar->userVector );
+   _braid_CountFcn(core, free)(app, ubar->userVector);
+   ubar->userVector = NULL;
 
    /* Free ubar */
    _braid_VectorBarDelete(core, ubar);
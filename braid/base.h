@@ -42,6 +42,30 @@
 extern "C" {
 #endif
 
+/**
+ * Allocate a cell from the core's slab for a braid_BaseVector or
+ * braid_VectorBar struct
+ */
+braid_Int
+_braid_SlabAlloc(braid_Core   core,       /**< braid_Core structure */
+                 void       **cell_ptr    /**< output, pointer to the allocated cell */
+                 );
+
+/**
+ * Return a cell allocated with _braid_SlabAlloc to the slab's free list
+ */
+braid_Int
+_braid_SlabFree(braid_Core   core,        /**< braid_Core structure */
+                void        *cell_ptr     /**< cell to free */
+                );
+
+/**
+ * Free all slab memory.  Any cells still in use become invalid.
+ */
+braid_Int
+_braid_SlabDestroy(braid_Core  core       /**< braid_Core structure */
+                   );
+
 /**
  * This calls the user's step routine.
  * If (adjoint): also record the action, and push state and bar vector to primal and bar tapes. 
@@ -53,7 +77,7 @@ _braid_BaseStep(braid_Core       core,       /**< braid_Core structure */
                 braid_BaseVector fstop,      /**< input, right-hand-side at *tstop* */
                 braid_BaseVector u,          /**< input/output, initially *u* vector at *tstart*, upon exit, *u* vector at *tstop* */   
                 braid_Int        level,      /**< current time grid level */ 
-                braid_StepStatus status );   /**< braid_Status structure (pointer to the core) */    
+                braid_StepStatus status );   /**< braid_Status structure */    
 
 
 /**
@@ -78,6 +102,76 @@ _braid_BaseClone(braid_Core         core,     /**< braid_Core structure */
                  braid_BaseVector   u,        /**< vector to clone */ 
                  braid_BaseVector  *v_ptr     /**< output, newly allocated and cloned vector */ 
                  );
+
+/**
+ * This calls the user's copy routine to overwrite the existing vector *v* with
+ * *u*.  Only used when the adjoint is off, as the action is not recorded.
+ */
+braid_Int
+_braid_BaseCopy(braid_Core         core,     /**< braid_Core structure */
+                braid_App          app,      /**< user-defined _braid_App structure */ 
+                braid_BaseVector   u,        /**< vector to copy */ 
+                braid_BaseVector   v         /**< output, existing vector overwritten with *u* */ 
+                );
+
+/**
+ * Set the level that user callbacks on the calling thread are charged to, and
+ * return the previous one in *old_level_ptr* (if not NULL).  A call is charged
+ * to the level of the vector it creates or updates, so operations that write
+ * to another level (coarsening, refinement, FRestrict on the coarse grid) set
+ * that level and restore the old one afterwards.
+ */
+braid_Int
+_braid_SetCallLevel(braid_Int   level,         /**< level to charge calls to */
+                    braid_Int  *old_level_ptr  /**< output, previous level (may be NULL) */
+                    );
+
+/**
+ * Count a call to user callback *call* (braid_Call_Init, ...) on the level set
+ * by _braid_SetCallLevel(), and track the number of live user vectors
+ */
+braid_Int
+_braid_CountCall(braid_Core  core,      /**< braid_Core structure */
+                 braid_Int   call       /**< callback counter to increment */
+                 );
+
+/**
+ * Return true if freed vectors can be recycled through the user's copy
+ * routine (copy is set, the pool is not empty, there is no adjoint or shells,
+ * and a buffer view is set if spatial coarsening is used)
+ */
+braid_Int
+_braid_BasePoolOn(braid_Core  core      /**< braid_Core structure */
+                  );
+
+/**
+ * Return the pool key of *u*, its size in bytes with spatial coarsening
+ * (through the buffer view) and 0 otherwise.  Only vectors with the same key
+ * are recycled for each other.
+ */
+braid_Int
+_braid_BasePoolKey(braid_Core        core,  /**< braid_Core structure */
+                   braid_BaseVector  u      /**< vector to key */
+                   );
+
+/**
+ * Take a pooled vector with pool key *key* (most recently freed first), or
+ * return NULL in *v_ptr* if there is none
+ */
+braid_Int
+_braid_BasePoolGet(braid_Core         core,    /**< braid_Core structure */
+                   braid_Int          key,     /**< pool key (see _braid_BasePoolKey) */
+                   braid_BaseVector  *v_ptr    /**< output, pooled vector or NULL */
+                   );
+
+/**
+ * Free the vectors kept for reuse by _braid_BaseClone (see braid_SetCopy)
+ */
+braid_Int
+_braid_BasePoolDestroy(braid_Core  core,      /**< braid_Core structure */
+                       braid_App   app        /**< user-defined _braid_App structure */
+                       );
+
 /**
  * This calls the user's free routine.
  * If (adjoint): also record the action, and free the bar vector. 
@@ -169,6 +263,18 @@ _braid_BaseBufUnpack(braid_Core           core,      /**< braid_Core structure *
                      braid_BufferStatus   status     /**< can be querried for info about the message type */
                      );
 
+/** 
+ * This calls the user's BufView routine.
+ * If (adjoint): nothing (zero-copy messages are not used for adjoint runs)
+ */
+braid_Int
+_braid_BaseBufView(braid_Core          core,        /**< braid_Core structure */
+                   braid_App           app,         /**< user-defined _braid_App structure */
+                   braid_BaseVector    u,           /**< vector to view */
+                   void              **data_ptr,    /**< output, pointer to the contiguous data of u */
+                   braid_Int          *size_ptr     /**< output, length of the data in bytes */
+                   );
+
 /** 
  * If (adjoint): This calls the user's ObjectiveT routine, records the action, and 
  *               pushes to the state and bar tapes. 
@@ -192,7 +298,7 @@ _braid_BaseResidual(braid_Core       core,             /**< braid_Core structure
                     braid_App        app,              /**< user-defined _braid_App structure */
                     braid_BaseVector ustop,            /**< input, *u* vector at *tstop* */
                     braid_BaseVector r,                /**< output, residual at *tstop* (at input, equals *u* at *tstart*) */
-                    braid_StepStatus status            /**< braid_Status structure (pointer to the core) */ 
+                    braid_StepStatus status            /**< braid_Status structure */ 
                     );
 
 /** 
@@ -204,7 +310,7 @@ _braid_BaseFullResidual(braid_Core        core,        /**< braid_Core structure
                         braid_App         app,         /**< user-defined _braid_App structure */
                         braid_BaseVector  r,           /**< output, residual at *tstop* */
                         braid_BaseVector  u,           /**< input, *u* vector at *tstop* */
-                        braid_StepStatus  status       /**< braid_Status structure (pointer to the core) */ 
+                        braid_StepStatus  status       /**< braid_Status structure */ 
                        );    
 
 /**
@@ -216,7 +322,7 @@ _braid_BaseSCoarsen(braid_Core              core,      /**< braid_Core structure
                     braid_App               app,       /**< user-defined _braid_App structure */
                     braid_BaseVector        fu,        /**< braid_BaseVector to refine*/
                     braid_BaseVector       *cu_ptr,    /**< output, refined vector */   
-                    braid_CoarsenRefStatus  status     /**< braid_Status structure (pointer to the core) */ 
+                    braid_CoarsenRefStatus  status     /**< braid_Status structure */ 
                     );
 
 /**
@@ -228,7 +334,7 @@ _braid_BaseSRefine(braid_Core              core,      /**< braid_Core structure
                    braid_App               app,       /**< user-defined _braid_App structure */
                    braid_BaseVector        cu,        /**< braid_BaseVector to refine*/
                    braid_BaseVector       *fu_ptr,    /**< output, refined vector */       
-                   braid_CoarsenRefStatus  status     /**< braid_Status structure (pointer to the core) */ 
+                   braid_CoarsenRefStatus  status     /**< braid_Status structure */ 
                    );
 
 /**
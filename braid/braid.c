@@ -24,6 +24,7 @@
  *
  */
 
+#include <string.h>
 #include "_braid.h"
 #include "util.h"
 
@@ -41,6 +42,7 @@ braid_Int
 braid_Drive(braid_Core  core)
 {
    MPI_Comm             comm_world      = _braid_CoreElt(core, comm_world);
+   MPI_Comm             comm            = _braid_CoreElt(core, comm);
    braid_Int            myid            = _braid_CoreElt(core, myid_world);
    braid_Real           tstart          = _braid_CoreElt(core, tstart);
    braid_Real           tstop           = _braid_CoreElt(core, tstop);
@@ -55,6 +57,14 @@ braid_Drive(braid_Core  core)
    braid_Real    *ta;
    _braid_Grid   *grid;
    braid_Real     localtime, globaltime;
+   braid_Real     delta_stats[2];
+   braid_Real     live_peak[2];
+   braid_Real     slab_stats[3];
+   braid_Int      size;
+   _braid_BufferStatus bstatus_s;
+   braid_BufferStatus  bstatus = &bstatus_s;
+
+   _braid_StatusInit(core, (braid_Status) bstatus);
 
    /* Check for non-supported adjoint features */
    if (adjoint)
@@ -156,6 +166,50 @@ braid_Drive(braid_Core  core)
    MPI_Allreduce(&localtime, &globaltime, 1, braid_MPI_REAL, MPI_MAX, comm_world);
    _braid_CoreElt(core, localtime)  = localtime;
    _braid_CoreElt(core, globaltime) = globaltime;
+   /* The receive wait is a temporal statistic, so reduce over the temporal
+    * communicator only, not over the spatial processors */
+   MPI_Allreduce(_braid_CoreElt(core, recv_wait), _braid_CoreElt(core, grecv_wait),
+                 _braid_CoreElt(core, nlevels), braid_MPI_REAL, MPI_MAX, comm);
+   for (i = 0; i < _braid_CoreElt(core, nlevels); i++)
+   {
+      _braid_GridMemory(core, _braid_CoreElt(core, grids)[i]);
+   }
+   MPI_Allreduce(_braid_CoreElt(core, mem_peak), _braid_CoreElt(core, gmem_peak),
+                 _braid_CoreElt(core, nlevels)*_braid_NMemStats, braid_MPI_REAL, MPI_SUM, comm_world);
+   MPI_Allreduce(_braid_CoreElt(core, ncalls), _braid_CoreElt(core, gncalls),
+                 _braid_CoreElt(core, nlevels)*braid_NCalls, braid_MPI_REAL, MPI_SUM, comm_world);
+   /* Estimate the peak bytes in user vectors from the buffer size */
+   _braid_BufferStatusInit(0, 0, bstatus);
+   _braid_BaseBufSize(core, app, &size, bstatus);
+   live_peak[0] = (braid_Real) _braid_CoreElt(core, nlive_peak);
+   live_peak[1] = live_peak[0] * size;
+   MPI_Allreduce(live_peak, _braid_CoreElt(core, glive_peak), 2, braid_MPI_REAL, MPI_MAX, comm_world);
+   slab_stats[0] = (braid_Real) _braid_CoreElt(core, slab_used);
+   slab_stats[1] = (braid_Real) _braid_CoreElt(core, slab_peak);
+   slab_stats[2] = (braid_Real) _braid_CoreElt(core, slab_nchunks)*_braid_SlabChunk;
+   MPI_Allreduce(slab_stats, _braid_CoreElt(core, gslab_stats), 3, braid_MPI_REAL, MPI_MAX, comm_world);
+   if (_braid_CoreElt(core, compress) != braid_COMPRESS_NONE)
+   {
+      MPI_Allreduce(_braid_CoreElt(core, comp_stats), _braid_CoreElt(core, gcomp_stats),
+                    2, braid_MPI_REAL, MPI_SUM, comm_world);
+      MPI_Allreduce(&_braid_CoreElt(core, comp_stats)[2], &_braid_CoreElt(core, gcomp_stats)[2],
+                    1, braid_MPI_REAL, MPI_MAX, comm_world);
+   }
+   if (_braid_CoreElt(core, delta_keyframe) > 0)
+   {
+      _braid_UDeltaStats(core, 0, delta_stats);
+      MPI_Allreduce(delta_stats, _braid_CoreElt(core, gdelta_stats),
+                    2, braid_MPI_REAL, MPI_SUM, comm_world);
+   }
+   if (_braid_CoreElt(core, ooc_path) != NULL)
+   {
+      MPI_Allreduce(_braid_CoreElt(core, ooc_stats), _braid_CoreElt(core, gooc_stats),
+                    2, braid_MPI_REAL, MPI_SUM, comm_world);
+      MPI_Allreduce(&_braid_CoreElt(core, ooc_stats)[2], &_braid_CoreElt(core, gooc_stats)[2],
+                    1, braid_MPI_REAL, MPI_MAX, comm_world);
+      MPI_Allreduce(&_braid_CoreElt(core, ooc_stats)[3], &_braid_CoreElt(core, gooc_stats)[3],
+                    1, braid_MPI_REAL, MPI_SUM, comm_world);
+   }
 
    /* Print statistics for this run */
    if ( (print_level > 1) && (myid == 0) )
@@ -197,6 +251,7 @@ braid_Init(MPI_Comm               comm_world,
    braid_Int              fmg             = 0;              /* Default fmg (0 is off) */
    braid_Int              nfmg            = -1;             /* Default fmg cycles is -1, indicating all fmg-cycles (if fmg=1) */
    braid_Int              nfmg_Vcyc       = 1;              /* Default num V-cycles at each fmg level is 1 */
+   braid_Int              cycle           = braid_CYCLE_V;  /* Default cycle type is V */
    braid_Int              max_iter        = 100;            /* Default max_iter */
    braid_Int              max_levels      = 30;             /* Default max_levels */
    braid_Int              incr_max_levels = 0;              /* Default increment max levels is false */
@@ -217,10 +272,11 @@ braid_Init(MPI_Comm               comm_world,
    braid_Int              obj_only        = 0;              /* Default objective only: Turned off */
    braid_Int              verbose_adj     = 0;              /* Default adjoint verbosity Turned off */
 
-   braid_Int              myid_world,  myid;
+   braid_Int              myid_world,  myid, nprocs;
 
    MPI_Comm_rank(comm_world, &myid_world);
    MPI_Comm_rank(comm, &myid);
+   MPI_Comm_size(comm, &nprocs);
 
    core = _braid_CTAlloc(_braid_Core, 1);
 
@@ -228,6 +284,7 @@ braid_Init(MPI_Comm               comm_world,
    _braid_CoreElt(core, comm)            = comm;
    _braid_CoreElt(core, myid_world)      = myid_world;
    _braid_CoreElt(core, myid)            = myid;
+   _braid_CoreElt(core, nprocs)          = nprocs;
    _braid_CoreElt(core, tstart)          = tstart;
    _braid_CoreElt(core, tstop)           = tstop;
    _braid_CoreElt(core, ntime)           = ntime;
@@ -251,6 +308,17 @@ braid_Init(MPI_Comm               comm_world,
    _braid_CoreElt(core, srefine)         = NULL;
    _braid_CoreElt(core, tgrid)           = NULL;
    _braid_CoreElt(core, sync)            = NULL;
+   _braid_CoreElt(core, bufview)         = NULL;
+   _braid_CoreElt(core, copy)            = NULL;
+   _braid_CoreElt(core, vpool_size)      = 0;
+   _braid_CoreElt(core, vpool_max)       = _braid_VPoolDefault;
+   _braid_CoreElt(core, vpool)           = _braid_CTAlloc(braid_BaseVector, _braid_VPoolDefault);
+   _braid_CoreElt(core, vpool_keys)      = _braid_CTAlloc(braid_Int, _braid_VPoolDefault);
+   _braid_CoreElt(core, slab_chunks)     = NULL;
+   _braid_CoreElt(core, slab_nchunks)    = 0;
+   _braid_CoreElt(core, slab_free)       = NULL;
+   _braid_CoreElt(core, slab_used)       = 0;
+   _braid_CoreElt(core, slab_peak)       = 0;
 
    _braid_CoreElt(core, access_level)    = access_level;
    _braid_CoreElt(core, tnorm)           = tnorm;
@@ -266,10 +334,20 @@ braid_Init(MPI_Comm               comm_world,
 
    _braid_CoreElt(core, nrels)           = NULL; /* Set with SetMaxLevels() below */
    _braid_CoreElt(core, nrdefault)       = nrdefault;
+   _braid_CoreElt(core, rscheds)         = NULL; /* Set with SetMaxLevels() below */
+   _braid_CoreElt(core, rsdefault)       = NULL;
    _braid_CoreElt(core, CWts)            = NULL; /* Set with SetMaxLevels() below */
    _braid_CoreElt(core, CWt_default)     = CWt_default;
 
    _braid_CoreElt(core, cfactors)        = NULL; /* Set with SetMaxLevels() below */
+   _braid_CoreElt(core, recv_wait)       = NULL; /* Set with SetMaxLevels() below */
+   _braid_CoreElt(core, grecv_wait)      = NULL; /* Set with SetMaxLevels() below */
+   _braid_CoreElt(core, mem_peak)        = NULL; /* Set with SetMaxLevels() below */
+   _braid_CoreElt(core, gmem_peak)       = NULL; /* Set with SetMaxLevels() below */
+   _braid_CoreElt(core, ncalls)          = NULL; /* Set with SetMaxLevels() below */
+   _braid_CoreElt(core, gncalls)         = NULL; /* Set with SetMaxLevels() below */
+   _braid_CoreElt(core, nlive)           = 0;
+   _braid_CoreElt(core, nlive_peak)      = 0;
    _braid_CoreElt(core, cfdefault)       = cfdefault;
 
    _braid_CoreElt(core, max_iter)        = 0; /* Set with SetMaxIter() below */
@@ -277,9 +355,39 @@ braid_Init(MPI_Comm               comm_world,
    _braid_CoreElt(core, fmg)             = fmg;
    _braid_CoreElt(core, nfmg)            = nfmg;
    _braid_CoreElt(core, nfmg_Vcyc)       = nfmg_Vcyc;
+   _braid_CoreElt(core, cycle)           = cycle;
+   _braid_CoreElt(core, ncycles)         = NULL; /* Set with SetMaxLevels() below */
+   _braid_CoreElt(core, ncdefault)       = -1;
+   _braid_CoreElt(core, nvisits)         = NULL; /* Set with SetMaxLevels() below */
 
    _braid_CoreElt(core, storage)         = -1;            /* only store C-points */
    _braid_CoreElt(core, useshell)         = 0;
+   _braid_CoreElt(core, reduced_storage) = -1;            /* full precision storage */
+   _braid_CoreElt(core, ooc_path)        = NULL;          /* C-points kept in memory */
+   _braid_CoreElt(core, ooc_window)      = 0;
+   _braid_CoreElt(core, ooc_fd)          = -1;
+   _braid_CoreElt(core, ooc_slot_size)   = 0;
+   _braid_CoreElt(core, ooc_ahead)       = NULL;
+   _braid_CoreElt(core, delta_keyframe)  = 0;             /* C-points stored in full */
+   _braid_CoreElt(core, delta_encode)    = NULL;
+   _braid_CoreElt(core, delta_decode)    = NULL;
+   _braid_CoreElt(core, gdelta_stats)[0] = 0.0;
+   _braid_CoreElt(core, gdelta_stats)[1] = 0.0;
+   _braid_CoreElt(core, persistent_comm) = 0;             /* persistent requests off by default */
+   _braid_CoreElt(core, comm_agg)        = 0;             /* message aggregation off by default */
+   _braid_CoreElt(core, shm)             = 0;             /* shared memory between neighbors on a node */
+   _braid_CoreElt(core, thread_safe)     = 0;             /* intervals are not done on threads by default */
+   _braid_CoreElt(core, shm_comm)        = MPI_COMM_NULL;
+   _braid_CoreElt(core, shm_slot_size)   = 0;
+   _braid_CoreElt(core, compress)        = braid_COMPRESS_NONE; /* no message compression by default */
+   _braid_CoreElt(core, compress_tol)    = 0.0;
+   _braid_CoreElt(core, packed_reals)    = 0;             /* BufPack may write integers, no lossy compression */
+   _braid_CoreElt(core, comp_buffer)     = NULL;
+   _braid_CoreElt(core, comp_buffer_size) = 0;
+   _braid_CoreElt(core, store_buffer)    = NULL;
+   _braid_CoreElt(core, store_buffer_size) = 0;
+   _braid_CoreElt(core, comp_words)      = NULL;
+   _braid_CoreElt(core, comp_nwords)     = 0;
 
    _braid_CoreElt(core, gupper)          = 0; /* Set with SetPeriodic() below */
 
@@ -309,6 +417,7 @@ braid_Init(MPI_Comm               comm_world,
    _braid_CoreElt(core, objT_diff)             = NULL;
    _braid_CoreElt(core, step_diff)             = NULL;
    _braid_CoreElt(core, reset_gradient)        = NULL;
+   _braid_CoreElt(core, init_zero)             = NULL;
    _braid_CoreElt(core, postprocess_obj)       = NULL;
    _braid_CoreElt(core, postprocess_obj_diff)  = NULL;
 
@@ -403,6 +512,14 @@ braid_Destroy(braid_Core  core)
       braid_Int               level;
 
       _braid_TFree(_braid_CoreElt(core, nrels));
+      for (level = 0; level < _braid_CoreElt(core, max_levels); level++)
+      {
+         _braid_TFree(_braid_CoreElt(core, rscheds)[level]);
+      }
+      _braid_TFree(_braid_CoreElt(core, rscheds));
+      _braid_TFree(_braid_CoreElt(core, rsdefault));
+      _braid_TFree(_braid_CoreElt(core, ncycles));
+      _braid_TFree(_braid_CoreElt(core, nvisits));
       _braid_TFree(_braid_CoreElt(core, CWts));
       _braid_TFree(_braid_CoreElt(core, rnorms));
       _braid_TFree(_braid_CoreElt(core, full_rnorms));
@@ -410,6 +527,15 @@ braid_Destroy(braid_Core  core)
       _braid_TFree(_braid_CoreElt(core, rfactors));
       _braid_TFree(_braid_CoreElt(core, tnorm_a));
       _braid_TFree(_braid_CoreElt(core, rdtvalues));
+      _braid_TFree(_braid_CoreElt(core, comp_buffer));
+      _braid_TFree(_braid_CoreElt(core, store_buffer));
+      _braid_TFree(_braid_CoreElt(core, comp_words));
+      _braid_TFree(_braid_CoreElt(core, recv_wait));
+      _braid_TFree(_braid_CoreElt(core, grecv_wait));
+      _braid_TFree(_braid_CoreElt(core, mem_peak));
+      _braid_TFree(_braid_CoreElt(core, gmem_peak));
+      _braid_TFree(_braid_CoreElt(core, ncalls));
+      _braid_TFree(_braid_CoreElt(core, gncalls));
 
       /* Destroy the optimization structure */
       _braid_CoreElt(core, record) = 0;
@@ -424,6 +550,14 @@ braid_Destroy(braid_Core  core)
          _braid_GridDestroy(core, grids[level]);
       }
       _braid_TFree(grids);
+      _braid_ShmDestroy(core);
+      _braid_OocDestroy(core);
+
+      /* Vectors freed above may have been recycled into the pool */
+      _braid_BasePoolDestroy(core, _braid_CoreElt(core, app));
+      _braid_TFree(_braid_CoreElt(core, vpool));
+      _braid_TFree(_braid_CoreElt(core, vpool_keys));
+      _braid_SlabDestroy(core);
 
       _braid_TFree(core);
    }
@@ -453,6 +587,8 @@ braid_PrintStats(braid_Core  core)
    braid_Real    tol           = _braid_CoreElt(core, tol);
    braid_Int     rtol          = _braid_CoreElt(core, rtol);
    braid_Int    *nrels         = _braid_CoreElt(core, nrels);
+   char        **rscheds       = _braid_CoreElt(core, rscheds);
+   char         *rsdefault     = _braid_CoreElt(core, rsdefault);
    braid_Real   *CWts          = _braid_CoreElt(core, CWts);
    /*braid_Int    *cfactors     = _braid_CoreElt(core, cfactors);*/
    braid_Int     max_iter      = _braid_CoreElt(core, max_iter);
@@ -472,11 +608,26 @@ braid_PrintStats(braid_Core  core)
    braid_Int     periodic      = _braid_CoreElt(core, periodic);
    braid_Int     adjoint       = _braid_CoreElt(core, adjoint);
    braid_Optim   optim         = _braid_CoreElt(core, optim);
+   braid_Int     compress      = _braid_CoreElt(core, compress);
+   braid_Real   *gcomp_stats   = _braid_CoreElt(core, gcomp_stats);
+   braid_Real   *gooc_stats    = _braid_CoreElt(core, gooc_stats);
+   braid_Real   *gdelta_stats  = _braid_CoreElt(core, gdelta_stats);
+   braid_Real   *grecv_wait    = _braid_CoreElt(core, grecv_wait);
+   braid_Real   *gmem_peak     = _braid_CoreElt(core, gmem_peak);
+   braid_Real   *gncalls       = _braid_CoreElt(core, gncalls);
+   braid_Real   *glive_peak    = _braid_CoreElt(core, glive_peak);
+   braid_Real   *gslab_stats   = _braid_CoreElt(core, gslab_stats);
+   braid_Int     cycle         = _braid_CoreElt(core, cycle);
+   braid_Int    *ncycles       = _braid_CoreElt(core, ncycles);
+   braid_Real   *nvisits       = _braid_CoreElt(core, nvisits);
 
    braid_Real    tol_adj;
    braid_Int     rtol_adj;
    braid_Real    rnorm, rnorm_adj;
-   braid_Int     level;
+   braid_Real    nsteps, cost;
+   char         *rsched;
+   braid_Int     nrscheds;
+   braid_Int     level, i;
 
    if (adjoint)
    {
@@ -559,18 +710,100 @@ braid_PrintStats(braid_Core  core)
       _braid_printf("  skip down cycle       = %d\n", skip);
       _braid_printf("  periodic              = %d\n", periodic);
       _braid_printf("  number of refinements = %d\n", nrefine);
+      if (compress != braid_COMPRESS_NONE)
+      {
+         _braid_printf("  compression           = %s\n",
+                       ( (compress == braid_COMPRESS_LOSSY) &&
+                         _braid_CoreElt(core, packed_reals) ) ? "lossy" : "lossless");
+         _braid_printf("  compression ratio     = %1.2f\n",
+                       (gcomp_stats[1] > 0.0) ? gcomp_stats[0]/gcomp_stats[1] : 1.0);
+         _braid_printf("  compression time      = %f\n", gcomp_stats[2]);
+      }
+      if (_braid_CoreElt(core, ooc_path) != NULL)
+      {
+         _braid_printf("  out-of-core window    = %d\n", _braid_CoreElt(core, ooc_window));
+         _braid_printf("  out-of-core spilled   = %1.3e bytes\n", gooc_stats[0]);
+         _braid_printf("  out-of-core fetched   = %1.3e bytes\n", gooc_stats[1]);
+         _braid_printf("  out-of-core readahead = %1.3e bytes\n", gooc_stats[3]);
+         _braid_printf("  out-of-core stall     = %f\n", gooc_stats[2]);
+      }
+      if (_braid_CoreElt(core, delta_keyframe) > 0)
+      {
+         _braid_printf("  delta keyframe        = %d\n", _braid_CoreElt(core, delta_keyframe));
+         _braid_printf("  delta storage ratio   = %1.2f\n",
+                       (gdelta_stats[1] > 0.0) ? gdelta_stats[0]/gdelta_stats[1] : 1.0);
+      }
+      _braid_printf("  vector slab cells     = %d in use, %d peak, %d allocated (max over procs)\n",
+                    (braid_Int) gslab_stats[0], (braid_Int) gslab_stats[1],
+                    (braid_Int) gslab_stats[2]);
       _braid_printf("\n");
-      _braid_printf("  level   time-pts   cfactor   nrelax   Crelax Wt\n");
+      nrscheds = 0;
+      for (level = 0; level < nlevels-1; level++)
+      {
+         if ( (rscheds[level] != NULL) || (rsdefault != NULL) )
+         {
+            nrscheds++;
+         }
+      }
+      _braid_printf("  level   time-pts   cfactor   nrelax   Crelax Wt%s\n",
+                    (nrscheds > 0) ? "   relax schedule" : "");
       for (level = 0; level < nlevels-1; level++)
       {
-         _braid_printf("  % 5d  % 8d  % 7d   % 6d        %1.2f\n",
+         rsched = (rscheds[level] != NULL) ? rscheds[level] : rsdefault;
+         _braid_printf("  % 5d  % 8d  % 7d   % 6d        %1.2f%s%s\n",
                        level, _braid_GridElt(grids[level], gupper),
-                       _braid_GridElt(grids[level], cfactor), nrels[level], CWts[level]);
+                       _braid_GridElt(grids[level], cfactor), nrels[level], CWts[level],
+                       (rsched != NULL) ? "        " : "", (rsched != NULL) ? rsched : "");
       }
       /* Print out coarsest level information */
       _braid_printf("  % 5d  % 8d  \n",
                     level, _braid_GridElt(grids[level], gupper) );
       _braid_printf("\n");
+      _braid_printf("  level   recv wait time (max over procs)\n");
+      for (level = 0; level < nlevels; level++)
+      {
+         _braid_printf("  % 5d   %e\n", level, grecv_wait[level]);
+      }
+      _braid_printf("\n");
+      _braid_printf("  level   full vectors   shells   shell savings   comm buffers   (peak bytes, sum over procs)\n");
+      for (level = 0; level < nlevels; level++)
+      {
+         _braid_printf("  % 5d   %e   % 6d   %e   %e\n", level,
+                       gmem_peak[level*_braid_NMemStats+_braid_MemFull],
+                       (braid_Int) gmem_peak[level*_braid_NMemStats+_braid_MemShells],
+                       gmem_peak[level*_braid_NMemStats+_braid_MemShellSaved],
+                       gmem_peak[level*_braid_NMemStats+_braid_MemComm]);
+      }
+      _braid_printf("\n");
+      _braid_printf("  level       init      clone       copy       free        sum       norm       pack     unpack       step    coarsen     refine   (calls, sum over procs)\n");
+      for (level = 0; level < nlevels; level++)
+      {
+         _braid_printf("  % 5d", level);
+         for (i = 0; i < braid_NCalls; i++)
+         {
+            _braid_printf(" % 10.0f", gncalls[level*braid_NCalls+i]);
+         }
+         _braid_printf("\n");
+      }
+      _braid_printf("\n");
+      _braid_printf("  cycle type            = %s\n", (cycle == braid_CYCLE_W) ? "W" :
+                    ((cycle == braid_CYCLE_F) || fmg) ? "F" : "V");
+      _braid_printf("  level    ncycles     visits      steps   (per iteration)\n");
+      cost = 0.0;
+      for (level = 0; level < nlevels; level++)
+      {
+         nsteps = gncalls[level*braid_NCalls+braid_Call_Step] / _braid_max(niter, 1);
+         cost  += nsteps;
+         _braid_printf("  % 5d  % 9d  % 9.2f  % 9.2f\n", level,
+                       (level == 0) ? 1 : (level < nlevels-1) ? ncycles[level] : 0,
+                       nvisits[level] / _braid_max(niter, 1), nsteps);
+      }
+      _braid_printf("  cycle cost            = %1.2f fine-grid steps per iteration\n",
+                    cost / _braid_max(gupper, 1));
+      _braid_printf("\n");
+      _braid_printf("  peak user vectors     = %d (%e bytes estimated, max over procs)\n",
+                    (braid_Int) glive_peak[0], glive_peak[1]);
+      _braid_printf("\n");
       _braid_printf("  wall time = %f\n", globaltime);
       _braid_printf("\n");
    }
@@ -644,28 +877,71 @@ braid_SetMaxLevels(braid_Core  core,
 {
    braid_Int              old_max_levels = _braid_CoreElt(core, max_levels);
    braid_Int             *nrels          = _braid_CoreElt(core, nrels);
+   char                 **rscheds        = _braid_CoreElt(core, rscheds);
+   braid_Int             *ncycles        = _braid_CoreElt(core, ncycles);
+   braid_Real            *nvisits        = _braid_CoreElt(core, nvisits);
    braid_Real            *CWts           = _braid_CoreElt(core, CWts);
    braid_Int             *cfactors       = _braid_CoreElt(core, cfactors);
+   braid_Real            *recv_wait      = _braid_CoreElt(core, recv_wait);
+   braid_Real            *grecv_wait     = _braid_CoreElt(core, grecv_wait);
+   braid_Real            *mem_peak       = _braid_CoreElt(core, mem_peak);
+   braid_Real            *gmem_peak      = _braid_CoreElt(core, gmem_peak);
+   braid_Real            *ncalls         = _braid_CoreElt(core, ncalls);
+   braid_Real            *gncalls        = _braid_CoreElt(core, gncalls);
    _braid_Grid          **grids          = _braid_CoreElt(core, grids);
+   braid_Int              i;
    braid_Int              level;
 
    _braid_CoreElt(core, max_levels) = max_levels;
 
    nrels = _braid_TReAlloc(nrels, braid_Int, max_levels);
+   rscheds = _braid_TReAlloc(rscheds, char *, max_levels);
+   ncycles = _braid_TReAlloc(ncycles, braid_Int, max_levels);
+   nvisits = _braid_TReAlloc(nvisits, braid_Real, max_levels);
    CWts = _braid_TReAlloc(CWts, braid_Real, max_levels);
    cfactors = _braid_TReAlloc(cfactors, braid_Int, max_levels);
    grids    = _braid_TReAlloc(grids, _braid_Grid *, max_levels);
+   recv_wait  = _braid_TReAlloc(recv_wait, braid_Real, max_levels);
+   grecv_wait = _braid_TReAlloc(grecv_wait, braid_Real, max_levels);
+   mem_peak   = _braid_TReAlloc(mem_peak, braid_Real, max_levels*_braid_NMemStats);
+   gmem_peak  = _braid_TReAlloc(gmem_peak, braid_Real, max_levels*_braid_NMemStats);
+   ncalls     = _braid_TReAlloc(ncalls, braid_Real, max_levels*braid_NCalls);
+   gncalls    = _braid_TReAlloc(gncalls, braid_Real, max_levels*braid_NCalls);
    for (level = old_max_levels; level < max_levels; level++)
    {
       nrels[level]    = -1;
+      rscheds[level]  = NULL;
+      ncycles[level]  = -1;
+      nvisits[level]  = 0.0;
       CWts[level]    = -1.0;
       cfactors[level] = 0;
       grids[level]    = NULL;
+      recv_wait[level]  = 0.0;
+      grecv_wait[level] = 0.0;
+      for (i = 0; i < _braid_NMemStats; i++)
+      {
+         mem_peak[level*_braid_NMemStats+i]  = 0.0;
+         gmem_peak[level*_braid_NMemStats+i] = 0.0;
+      }
+      for (i = 0; i < braid_NCalls; i++)
+      {
+         ncalls[level*braid_NCalls+i]  = 0.0;
+         gncalls[level*braid_NCalls+i] = 0.0;
+      }
    }
    _braid_CoreElt(core, nrels)    = nrels;
+   _braid_CoreElt(core, rscheds)  = rscheds;
+   _braid_CoreElt(core, ncycles)  = ncycles;
+   _braid_CoreElt(core, nvisits)  = nvisits;
    _braid_CoreElt(core, CWts)     = CWts;
    _braid_CoreElt(core, cfactors) = cfactors;
    _braid_CoreElt(core, grids)    = grids;
+   _braid_CoreElt(core, recv_wait)  = recv_wait;
+   _braid_CoreElt(core, grecv_wait) = grecv_wait;
+   _braid_CoreElt(core, mem_peak)   = mem_peak;
+   _braid_CoreElt(core, gmem_peak)  = gmem_peak;
+   _braid_CoreElt(core, ncalls)     = ncalls;
+   _braid_CoreElt(core, gncalls)    = gncalls;
 
    return _braid_error_flag;
 }
@@ -874,6 +1150,65 @@ braid_SetCRelaxWt(braid_Core  core,
    return _braid_error_flag;
 }
 
+/*--------------------------------------------------------------------------
+ *--------------------------------------------------------------------------*/
+
+braid_Int
+braid_SetRelaxSchedule(braid_Core   core,
+                       braid_Int    level,
+                       const char  *schedule)
+{
+   char        *rsched;
+   const char  *p;
+   char        *end;
+   braid_Int    csweep = 0;
+
+   /* Check the schedule, F- and C-sweeps with an optional weight after a C.
+    * A C right after another C does not step the F-points again, so without
+    * a weight it would recompute the same C-points. */
+   for (p = schedule; *p != '\0'; )
+   {
+      if (*p == 'F')
+      {
+         csweep = 0;
+         p++;
+      }
+      else if (*p == 'C')
+      {
+         strtod(p+1, &end);
+         if ( csweep && (end == (p+1)) )
+         {
+            _braid_Error(braid_ERROR_ARG, "Invalid relaxation schedule, a repeated C needs a weight");
+            return _braid_error_flag;
+         }
+         csweep = 1;
+         p = end;
+      }
+      else
+      {
+         _braid_Error(braid_ERROR_ARG, "Invalid relaxation schedule");
+         return _braid_error_flag;
+      }
+   }
+
+   rsched = _braid_TAlloc(char, strlen(schedule)+1);
+   strcpy(rsched, schedule);
+   if (level < 0)
+   {
+      /* Set default value */
+      _braid_TFree(_braid_CoreElt(core, rsdefault));
+      _braid_CoreElt(core, rsdefault) = rsched;
+   }
+   else
+   {
+      /* Set schedule on specified level */
+      _braid_TFree(_braid_CoreElt(core, rscheds)[level]);
+      _braid_CoreElt(core, rscheds)[level] = rsched;
+   }
+
+   return _braid_error_flag;
+}
+
 /*--------------------------------------------------------------------------
  *--------------------------------------------------------------------------*/
 
@@ -1008,6 +1343,47 @@ braid_SetNFMG(braid_Core  core,
    return _braid_error_flag;
 }
 
+/*--------------------------------------------------------------------------
+ *--------------------------------------------------------------------------*/
+
+braid_Int
+braid_SetCycle(braid_Core  core,
+               braid_Int   cycle)
+{
+   if ( (cycle < braid_CYCLE_V) || (cycle > braid_CYCLE_W) )
+   {
+      _braid_Error(braid_ERROR_ARG, "Invalid cycle type");
+      return _braid_error_flag;
+   }
+   _braid_CoreElt(core, cycle) = cycle;
+
+   return _braid_error_flag;
+}
+
+/*--------------------------------------------------------------------------
+ *--------------------------------------------------------------------------*/
+
+braid_Int
+braid_SetNCycles(braid_Core  core,
+                 braid_Int   level,
+                 braid_Int   ncycles)
+{
+   braid_Int  *ncycs = _braid_CoreElt(core, ncycles);
+
+   if (level < 0)
+   {
+      /* Set default value */
+      _braid_CoreElt(core, ncdefault) = ncycles;
+   }
+   else
+   {
+      /* Set number of cycles on specified level */
+      ncycs[level] = ncycles;
+   }
+
+   return _braid_error_flag;
+}
+
 /*--------------------------------------------------------------------------
  *--------------------------------------------------------------------------*/
 
@@ -1020,6 +1396,132 @@ braid_SetStorage(braid_Core  core,
    return _braid_error_flag;
 }
 
+/*--------------------------------------------------------------------------
+ *--------------------------------------------------------------------------*/
+
+braid_Int
+braid_SetReducedStorage(braid_Core  core,
+                        braid_Int   level)
+{
+   _braid_CoreElt(core, reduced_storage) = level;
+
+   return _braid_error_flag;
+}
+
+/*--------------------------------------------------------------------------
+ *--------------------------------------------------------------------------*/
+
+braid_Int
+braid_SetOutOfCore(braid_Core   core,
+                   const char  *path,
+                   braid_Int    window)
+{
+   _braid_TFree(_braid_CoreElt(core, ooc_path));
+   if (path != NULL)
+   {
+      _braid_CoreElt(core, ooc_path) = _braid_TAlloc(char, strlen(path)+1);
+      strcpy(_braid_CoreElt(core, ooc_path), path);
+   }
+   _braid_CoreElt(core, ooc_window) = window;
+
+   return _braid_error_flag;
+}
+
+/*--------------------------------------------------------------------------
+ *--------------------------------------------------------------------------*/
+
+braid_Int
+braid_SetDeltaStorage(braid_Core              core,
+                      braid_Int               keyframe,
+                      braid_PtFcnDeltaEncode  encode,
+                      braid_PtFcnDeltaDecode  decode)
+{
+   _braid_CoreElt(core, delta_keyframe) = (keyframe > 1) ? keyframe : 0;
+   _braid_CoreElt(core, delta_encode)   = encode;
+   _braid_CoreElt(core, delta_decode)   = decode;
+
+   return _braid_error_flag;
+}
+
+/*--------------------------------------------------------------------------
+ *--------------------------------------------------------------------------*/
+
+braid_Int
+braid_SetPersistentComm(braid_Core  core,
+                        braid_Int   persistent_comm)
+{
+   _braid_CoreElt(core, persistent_comm) = persistent_comm;
+
+   return _braid_error_flag;
+}
+
+/*--------------------------------------------------------------------------
+ *--------------------------------------------------------------------------*/
+
+braid_Int
+braid_SetCommAggregate(braid_Core  core,
+                       braid_Int   comm_agg)
+{
+   _braid_CoreElt(core, comm_agg) = comm_agg;
+
+   return _braid_error_flag;
+}
+
+/*--------------------------------------------------------------------------
+ *--------------------------------------------------------------------------*/
+
+braid_Int
+braid_SetShmComm(braid_Core  core,
+                 braid_Int   shm)
+{
+   _braid_CoreElt(core, shm) = shm;
+
+   return _braid_error_flag;
+}
+
+/*--------------------------------------------------------------------------
+ *--------------------------------------------------------------------------*/
+
+braid_Int
+braid_SetThreadSafe(braid_Core  core,
+                    braid_Int   thread_safe)
+{
+   _braid_CoreElt(core, thread_safe) = thread_safe;
+
+   return _braid_error_flag;
+}
+
+/*--------------------------------------------------------------------------
+ *--------------------------------------------------------------------------*/
+
+braid_Int
+braid_SetCompression(braid_Core  core,
+                     braid_Int   method,
+                     braid_Real  tol)
+{
+   if ( (method < braid_COMPRESS_NONE) || (method > braid_COMPRESS_LOSSY) || (tol < 0.0) )
+   {
+      _braid_Error(braid_ERROR_ARG, "Invalid compression method or tolerance");
+      return _braid_error_flag;
+   }
+   _braid_CoreElt(core, compress)     = method;
+   _braid_CoreElt(core, compress_tol) = tol;
+
+   return _braid_error_flag;
+}
+
+/*--------------------------------------------------------------------------
+ *--------------------------------------------------------------------------*/
+
+braid_Int
+braid_SetPackedReals(braid_Core  core,
+                     braid_Int   packed_reals)
+{
+   _braid_CoreElt(core, packed_reals) = packed_reals;
+
+   return _braid_error_flag;
+}
+
 /*--------------------------------------------------------------------------
  *--------------------------------------------------------------------------*/
 
@@ -1130,6 +1632,54 @@ braid_SetSync(braid_Core      core,
    return _braid_error_flag;
 }
 
+/*--------------------------------------------------------------------------
+ *--------------------------------------------------------------------------*/
+
+braid_Int
+braid_SetBufView(braid_Core          core,
+                 braid_PtFcnBufView  bufview)
+{
+   _braid_CoreElt(core, bufview) = bufview;
+
+   return _braid_error_flag;
+}
+
+/*--------------------------------------------------------------------------
+ *--------------------------------------------------------------------------*/
+
+braid_Int
+braid_SetVectorPool(braid_Core  core,
+                    braid_Int   vpool_max)
+{
+   if (vpool_max < 0)
+   {
+      _braid_Error(braid_ERROR_ARG, "Invalid vector pool size");
+      return _braid_error_flag;
+   }
+
+   /* Release any pooled vectors before resizing */
+   _braid_BasePoolDestroy(core, _braid_CoreElt(core, app));
+   _braid_TFree(_braid_CoreElt(core, vpool));
+   _braid_TFree(_braid_CoreElt(core, vpool_keys));
+   _braid_CoreElt(core, vpool)      = _braid_CTAlloc(braid_BaseVector, vpool_max);
+   _braid_CoreElt(core, vpool_keys) = _braid_CTAlloc(braid_Int, vpool_max);
+   _braid_CoreElt(core, vpool_max)  = vpool_max;
+
+   return _braid_error_flag;
+}
+
+/*--------------------------------------------------------------------------
+ *--------------------------------------------------------------------------*/
+
+braid_Int
+braid_SetCopy(braid_Core       core,
+              braid_PtFcnCopy  copy)
+{
+   _braid_CoreElt(core, copy) = copy;
+
+   return _braid_error_flag;
+}
+
 /*--------------------------------------------------------------------------
  *--------------------------------------------------------------------------*/
 
@@ -1185,6 +1735,43 @@ braid_GetNLevels(braid_Core  core,
    return _braid_error_flag;
 }
 
+/*--------------------------------------------------------------------------
+ *--------------------------------------------------------------------------*/
+
+braid_Int
+braid_GetCallCounts(braid_Core  core,
+                    braid_Int   level,
+                    braid_Int  *counts)
+{
+   braid_Real  *ncalls = _braid_CoreElt(core, ncalls);
+   braid_Int    i;
+
+   for (i = 0; i < braid_NCalls; i++)
+   {
+      counts[i] = 0;
+      if ( (level >= 0) && (level < _braid_CoreElt(core, max_levels)) )
+      {
+         counts[i] = (braid_Int) ncalls[level*braid_NCalls+i];
+      }
+   }
+
+   return _braid_error_flag;
+}
+
+/*--------------------------------------------------------------------------
+ *--------------------------------------------------------------------------*/
+
+braid_Int
+braid_GetNVectors(braid_Core  core,
+                  braid_Int  *nlive_ptr,
+                  braid_Int  *npeak_ptr)
+{
+   *nlive_ptr = _braid_CoreElt(core, nlive);
+   *npeak_ptr = _braid_CoreElt(core, nlive_peak);
+
+   return _braid_error_flag;
+}
+
 /*--------------------------------------------------------------------------
  *--------------------------------------------------------------------------*/
 
@@ -1476,6 +2063,18 @@ braid_GetRNormAdjoint(braid_Core  core,
    return _braid_error_flag;
 }
 
+/*--------------------------------------------------------------------------
+ *--------------------------------------------------------------------------*/
+
+braid_Int
+braid_SetInitZero(braid_Core           core,
+                  braid_PtFcnInitZero  init_zero)
+{
+   _braid_CoreElt(core, init_zero) = init_zero;
+
+   return _braid_error_flag;
+}
+
 /*--------------------------------------------------------------------------
  *--------------------------------------------------------------------------*/
 
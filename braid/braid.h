@@ -262,6 +262,64 @@ typedef braid_Int
                         braid_BufferStatus   status         /**< can be querried for info on the current message type */
                         );
 
+/**
+ * (Optional) Returns a view of a braid_Vector _u_ whose data is stored as a
+ * single contiguous array: a pointer to the data and its length in bytes.  If
+ * set, XBraid sends directly from and receives directly into vector memory,
+ * instead of going through BufPack and BufUnpack.  The view must cover all of
+ * the data needed to reconstruct _u_, and a vector created by Init must have
+ * the same view length as the vectors being sent.
+ **/
+typedef braid_Int
+(*braid_PtFcnBufView)(braid_App      app,           /**< user-defined _braid_App structure */
+                      braid_Vector   u,             /**< vector to view */
+                      void         **data_ptr,      /**< output, pointer to the contiguous data of u */
+                      braid_Int     *size_ptr       /**< output, length of the data in bytes */
+                      );
+
+/**
+ * (Optional) Copy the data of *u* into the existing vector *v*, which was
+ * created by Init or Clone and has the same spatial size.  If set, XBraid
+ * recycles freed vectors and clones by copying into one of them instead of
+ * allocating a new vector.
+ **/
+typedef braid_Int
+(*braid_PtFcnCopy)(braid_App      app,           /**< user-defined _braid_App structure */
+                   braid_Vector   u,             /**< vector to copy */
+                   braid_Vector   v              /**< output, existing vector overwritten with u */
+                   );
+
+/**
+ * (Optional) Encodes the packed buffer of a C-point relative to a reference
+ * buffer (both as packed by *my_BufPack*) for delta storage, see @ref
+ * braid_SetDeltaStorage.  At most *size* bytes may be written to *delta*.  If
+ * the encoding does not fit, set *delta_size_ptr* to -1 and the buffer is
+ * stored as is.
+ **/
+typedef braid_Int
+(*braid_PtFcnDeltaEncode)(braid_App    app,            /**< user-defined _braid_App structure */
+                          void        *ref,            /**< reference buffer */
+                          braid_Int    ref_size,       /**< size of the reference buffer in bytes */
+                          void        *buffer,         /**< buffer to encode */
+                          braid_Int    size,           /**< size of the buffer in bytes */
+                          void        *delta,          /**< output, encoded buffer (at most size bytes) */
+                          braid_Int   *delta_size_ptr  /**< output, size of the encoded buffer in bytes, -1 if it does not fit */
+                          );
+
+/**
+ * (Optional) Decodes a buffer encoded by @ref braid_PtFcnDeltaEncode with the
+ * same reference buffer.
+ **/
+typedef braid_Int
+(*braid_PtFcnDeltaDecode)(braid_App    app,            /**< user-defined _braid_App structure */
+                          void        *ref,            /**< reference buffer */
+                          braid_Int    ref_size,       /**< size of the reference buffer in bytes */
+                          void        *delta,          /**< encoded buffer */
+                          braid_Int    delta_size,     /**< size of the encoded buffer in bytes */
+                          void        *buffer,         /**< output, decoded buffer */
+                          braid_Int    size            /**< size of the decoded buffer in bytes */
+                          );
+
 /**
  * This function (optional) computes the residual *r* at time *tstop*.  On
  * input, *r* holds the value of *u* at *tstart*, and *ustop* is the value of
@@ -456,6 +514,18 @@ typedef braid_Int
 (*braid_PtFcnResetGradient)(braid_App app          /**< output: user-defined _braid_App structure, used to store gradient */
                            );
 
+/**
+ * This function (optional) allocates a new vector at time *t* and sets it to
+ * zero.  It is used to create adjoint (bar) vectors, which otherwise are
+ * created with *Init()* followed by *Sum()* to zero them.  If used, set with
+ * @ref braid_SetInitZero.
+ **/
+typedef braid_Int
+(*braid_PtFcnInitZero)(braid_App      app,        /**< user-defined _braid_App structure */
+                       braid_Real     t,          /**< time value for *u_ptr* */
+                       braid_Vector  *u_ptr       /**< output, newly allocated and zeroed vector */
+                      );
+
 /** @}*/
 
 /*--------------------------------------------------------------------------
@@ -641,6 +711,30 @@ braid_SetCRelaxWt(braid_Core  core,        /**< braid_Core (_braid_Core) struct*
                   braid_Real  Cwt          /**< C-relaxation weight to use on *level* */
                   );
 
+/**
+ * Set the relaxation schedule on grid *level* (level 0 is the finest grid) as
+ * a string of F- and C-sweeps done from left to right, e.g., "F", "FCF",
+ * "FCFCF" or "FCC0.7F".  A C may be followed by a number, which is the weight
+ * used for that C-sweep instead of the one set by braid_SetCRelaxWt().
+ * Adjacent F-sweeps are fused into one.  A C right after another C relaxes the
+ * C-points again from the F-points of the sweep before it, without stepping
+ * the F-points.  It gets the same step result, so it only changes the C-points
+ * through its weight w, as u = w Phi(u_F) + (1-w) u, and must be given one
+ * explicitly (e.g., "FC0.7C1.2F"); a repeated C without a weight is an
+ * argument error.  A C at the start is done after an F-sweep, since the
+ * F-points are not current after interpolation.  The last F-sweep is always
+ * done as part of the restriction, so it is implied if the schedule ends in a
+ * C.  Hence, "FCF" is the same as braid_SetNRelax() with 1, and "F" with 0.
+ * To set the default for all levels, use *level = -1*.  A schedule takes the
+ * place of braid_SetNRelax() on its levels, except on the coarsest level.  By
+ * default, no schedule is set.
+ **/
+braid_Int
+braid_SetRelaxSchedule(braid_Core   core,      /**< braid_Core (_braid_Core) struct*/
+                       braid_Int    level,     /**< *level* to set the schedule on */
+                       const char  *schedule   /**< sweeps to do on *level*, e.g., "FCF" */
+                       );
+
 /**
  * Set the coarsening factor *cfactor* on grid *level* (level 0 is
  * the finest grid).  The default factor is 2 on all levels.  To change the
@@ -683,6 +777,40 @@ braid_SetNFMGVcyc(braid_Core  core,         /**< braid_Core (_braid_Core) struct
                   braid_Int   nfmg_Vcyc     /**< number of V-cycles to do each FMG level */
                   );
 
+/** Cycle types for braid_SetCycle */
+#define braid_CYCLE_V  0
+#define braid_CYCLE_F  1
+#define braid_CYCLE_W  2
+
+/**
+ * Set the multigrid cycle type.  With braid_CYCLE_V, each level below the
+ * finest does one coarse-grid correction per visit.  With braid_CYCLE_W, it
+ * does two, which adds coarse-level work for problems where V-cycle
+ * convergence degrades with the number of levels.  The number of corrections
+ * on each level can be changed with braid_SetNCycles().  braid_CYCLE_F does
+ * F-cycles on every iteration, the same as braid_SetFMG() (see also
+ * braid_SetNFMG() and braid_SetNFMGVcyc()).  The levels visited and the step
+ * calls per iteration of the cycle are shown by braid_PrintStats.  Default is
+ * braid_CYCLE_V.
+ **/
+braid_Int
+braid_SetCycle(braid_Core  core,            /**< braid_Core (_braid_Core) struct*/
+               braid_Int   cycle            /**< cycle type, braid_CYCLE_V, braid_CYCLE_F or braid_CYCLE_W */
+               );
+
+/**
+ * Set the number of coarse-grid corrections done on grid *level* each time it
+ * is visited (level 0 is the finest grid and always does one per iteration).
+ * A value of 1 gives V-cycles and 2 gives W-cycles.  If *level* is negative,
+ * *ncycles* is used for all levels not set individually.  The default is set
+ * by braid_SetCycle().
+ **/
+braid_Int
+braid_SetNCycles(braid_Core  core,          /**< braid_Core (_braid_Core) struct*/
+                 braid_Int   level,         /**< *level* to set ncycles on */
+                 braid_Int   ncycles        /**< number of coarse-grid corrections */
+                 );
+
 
 /**
  * Sets the storage properties of the code.
@@ -695,6 +823,170 @@ braid_SetStorage(braid_Core  core,          /**< braid_Core (_braid_Core) struct
                  braid_Int   storage        /**< storage property */
                 );
 
+/**
+ * Store the C-points on levels >= *level* in reduced (single) precision.  The
+ * vectors are packed with *my_BufPack*, and each braid_Real in the buffer is
+ * kept as a float, which halves the storage.  Since every 8 bytes of the buffer
+ * are rounded as a braid_Real, this requires the application to declare with
+ * braid_SetPackedReals that *my_BufPack* writes nothing else; otherwise the
+ * buffers are stored as is.  They are unpacked with *my_BufUnpack* when
+ * needed.  Stored C-points only provide initial guesses and the FAS
+ * restriction, but the rounding error still limits the attainable residual to
+ * about single precision relative to the solution.  Buffers with values out of
+ * the float range are kept as is.  Not used for adjoint runs or with shell
+ * vectors.  Default is -1 (off).
+ **/
+braid_Int
+braid_SetReducedStorage(braid_Core  core,          /**< braid_Core (_braid_Core) struct*/
+                        braid_Int   level          /**< finest level with reduced precision C-points, -1 for off */
+                       );
+
+/**
+ * Keep the level 0 C-points out of core, in a file named *path*.<rank> on
+ * each processor (removed when it is closed).  The vectors are packed with
+ * *my_BufPack*, in reduced precision if set with braid_SetReducedStorage, and
+ * unpacked with *my_BufUnpack* when needed.  After a point is read, the next
+ * one in the right-to-left order of the relaxation, restriction and
+ * interpolation sweeps is read ahead asynchronously (with POSIX aio, where
+ * available; otherwise all reads are synchronous).  The first *window* local
+ * C-points stay in memory.  This assumes that *my_BufSize* returns the same
+ * size on every call (larger vectors stay in memory).  The spilled and fetched
+ * bytes, the fetched bytes that were read ahead, and the time stalled waiting
+ * for reads are shown by braid_PrintStats.
+ * Not used for adjoint runs or with shell vectors.  Default is NULL (off).
+ **/
+braid_Int
+braid_SetOutOfCore(braid_Core   core,          /**< braid_Core (_braid_Core) struct*/
+                   const char  *path,          /**< file name prefix, NULL for off */
+                   braid_Int    window         /**< number of local C-points kept in memory */
+                  );
+
+/**
+ * Store the level 0 C-points as differences to a keyframe, for solutions that
+ * vary slowly in time.  The local C-points are grouped in runs of *keyframe*
+ * points.  Each group keeps one full packed reference (the value of its first
+ * point when that point was last stored), and each point of the group is
+ * stored as its difference to the reference.  The default encoding XORs the
+ * braid_Reals of the buffer with those of the reference and keeps only the
+ * significant bytes, so it is lossless.  A user codec may be given with
+ * *encode* and *decode* (NULL for the default).  When the first point of a
+ * group changes, the other points of the group are re-encoded against its new
+ * value.  Points are unpacked with *my_BufUnpack* when needed.  Replaces
+ * reduced precision and out-of-core storage on level 0.  Not used for adjoint
+ * runs or with shell vectors.  Default is 0 (off).
+ **/
+braid_Int
+braid_SetDeltaStorage(braid_Core              core,      /**< braid_Core (_braid_Core) struct*/
+                      braid_Int               keyframe,  /**< number of C-points per keyframe group, 0 or 1 for off */
+                      braid_PtFcnDeltaEncode  encode,    /**< user encoding routine, NULL for the default */
+                      braid_PtFcnDeltaDecode  decode     /**< user decoding routine, NULL for the default */
+                      );
+
+/**
+ * Use persistent MPI requests (MPI_Send_init / MPI_Recv_init) for the
+ * neighbor exchange on each level.  The requests are set up once when the
+ * grid hierarchy is built (and again after refinement), and only started and
+ * completed during the cycle.  This assumes that *my_BufSize* returns the same
+ * size on every call.  Default is 0 (off).
+ **/
+braid_Int
+braid_SetPersistentComm(braid_Core  core,             /**< braid_Core (_braid_Core) struct*/
+                        braid_Int   persistent_comm   /**< boolean, use persistent requests */
+                       );
+
+/**
+ * Aggregate vectors going to the same neighbor within one phase into a single
+ * message (with the vector count in a small header).  Currently this combines
+ * the coarse-grid boundary update in restriction with the fine-grid exchange,
+ * saving one message per processor and level in each down-cycle.  Not used
+ * for adjoint or periodic runs.  Default is 0 (off).
+ **/
+braid_Int
+braid_SetCommAggregate(braid_Core  core,        /**< braid_Core (_braid_Core) struct*/
+                       braid_Int   comm_agg     /**< boolean, aggregate messages */
+                      );
+
+/**
+ * Exchange vectors with temporal neighbors on the same node through shared
+ * memory (an MPI-3 shared window found with MPI_Comm_split_type) instead of
+ * MPI messages.  The sender packs its vector straight into a slot owned by the
+ * receiver, so no send buffer or MPI copy is needed.  There are two slots per
+ * level and communication phase, so a sender only waits if it is two
+ * messages ahead.  Waiting processors spin briefly and then yield, but this
+ * still works best with one processor per core.  This assumes that
+ * *my_BufSize* returns the same size on every call, and it is set up when the
+ * grid hierarchy is built, so call it before braid_Drive.  Not used for
+ * adjoint or periodic runs, and it takes precedence over the other message
+ * options for neighbors on the same node.  Default is 0 (off).
+ **/
+braid_Int
+braid_SetShmComm(braid_Core  core,        /**< braid_Core (_braid_Core) struct*/
+                 braid_Int   shm          /**< boolean, use shared memory */
+                );
+
+/**
+ * Declare that the user's *my_Step*, *my_Sum*, *my_SpatialNorm* (and
+ * *my_Residual*, if set) can be called from several threads at once, on
+ * different vectors.  The intervals of each processor are then relaxed,
+ * restricted and interpolated by a pool of OpenMP threads (OMP_NUM_THREADS),
+ * except for the first and last intervals, which communicate with the
+ * neighbors.  The intervals are split into a few blocks per thread, handed out
+ * as threads become free, so steps of uneven cost are balanced.  The sweeps of
+ * relaxation run as a task graph over the blocks, so a block starts its next
+ * sweep as soon as its neighbors are done with the previous one.  This allows
+ * fewer processors in time with more threads each.  The other user routines
+ * are still called one at a time, and all MPI calls are made by the master
+ * thread.  The one exception is *my_Clone* with a buffer view (see
+ * braid_SetBufView): a vector that is overwritten while it is still being sent
+ * is cloned on the thread that overwrites it, so *my_Clone* must then be
+ * thread safe as well.  Requires building XBraid and the application with
+ * OpenMP (make openmp=yes), and is not used for adjoint or periodic runs.
+ * Default is 0 (off).
+ **/
+braid_Int
+braid_SetThreadSafe(braid_Core  core,          /**< braid_Core (_braid_Core) struct*/
+                    braid_Int   thread_safe    /**< boolean, Step is thread safe */
+                   );
+
+/** Compression methods for braid_SetCompression */
+#define braid_COMPRESS_NONE      0
+#define braid_COMPRESS_LOSSLESS  1
+#define braid_COMPRESS_LOSSY     2
+
+/**
+ * Compress vector messages between processors after *my_BufPack* (and
+ * decompress them before *my_BufUnpack*).  Both methods assume the packed
+ * buffer is mostly an array of braid_Reals, which is typical.  The lossless
+ * method stores only the bytes that change between consecutive values.  The
+ * lossy method rounds each value to within *tol* times the current residual
+ * norm, so it is coarse while the residual is large and accurate near
+ * convergence.  It treats every 8 bytes of the buffer as a braid_Real, so it
+ * is only used if the application declares with braid_SetPackedReals that
+ * *my_BufPack* writes nothing else (store sizes and other integers as
+ * braid_Reals, which are kept exact); otherwise it falls back to lossless, as
+ * it does until the first residual norm is available.  Buffers that
+ * do not compress are sent as is.  Compression ratio and time are shown by
+ * braid_PrintStats.  Not used for adjoint runs, zero-copy (braid_SetBufView)
+ * or aggregated messages, and it disables the persistent requests of
+ * braid_SetPersistentComm.  Default is braid_COMPRESS_NONE.
+ **/
+braid_Int
+braid_SetCompression(braid_Core  core,        /**< braid_Core (_braid_Core) struct*/
+                     braid_Int   method,      /**< braid_COMPRESS_NONE, braid_COMPRESS_LOSSLESS, or braid_COMPRESS_LOSSY */
+                     braid_Real  tol          /**< lossy error bound relative to the residual norm */
+                    );
+
+/**
+ * Declare that *my_BufPack* writes only braid_Reals (no C integers or other
+ * data), so the buffer may be rounded value by value.  Required for
+ * braid_COMPRESS_LOSSY in braid_SetCompression and for
+ * braid_SetReducedStorage.  Default is 0 (no).
+ **/
+braid_Int
+braid_SetPackedReals(braid_Core  core,          /**< braid_Core (_braid_Core) struct*/
+                     braid_Int   packed_reals   /**< boolean, BufPack writes only braid_Reals */
+                    );
+
 /** 
  * Sets XBraid temporal norm.
  *
@@ -789,6 +1081,47 @@ braid_SetSync(braid_Core      core, /**< braid_Core (_braid_Core) struct*/
               braid_PtFcnSync sync  /**< function pointer to sync routine */
               );
 
+/**
+ * Set the (optional) buffer view routine for zero-copy communication, see
+ * @ref braid_PtFcnBufView.  The view is used instead of BufPack/BufUnpack for
+ * the neighbor exchange, except for adjoint runs and when spatial coarsening
+ * is used.  A vector is sent in place, and it is only cloned if XBraid needs
+ * to overwrite it before the send completes (with braid_SetThreadSafe, this
+ * clone may be made on any thread, see there).  If a copy routine is also set
+ * (see braid_SetCopy), messages are received into recycled vectors instead of
+ * new ones from Init.  Default is no buffer view routine.
+ **/
+braid_Int
+braid_SetBufView(braid_Core          core,     /**< braid_Core (_braid_Core) struct*/
+                 braid_PtFcnBufView  bufview   /**< function pointer to buffer view routine */
+                 );
+
+/**
+ * Set the (optional) copy routine, see @ref braid_PtFcnCopy.  This turns on a
+ * small pool of recycled vectors: freed vectors are kept (see
+ * braid_SetVectorPool for how many) and clones copy into a pooled vector
+ * instead of calling Clone.  With spatial coarsening, vectors on different
+ * levels may differ in size, so the pool is only used if a buffer view is also
+ * set (see braid_SetBufView), and a vector is only recycled for one of the
+ * same size.  Not used for adjoint runs or with shell vectors.
+ * Default is no copy routine.
+ **/
+braid_Int
+braid_SetCopy(braid_Core       core,     /**< braid_Core (_braid_Core) struct*/
+              braid_PtFcnCopy  copy      /**< function pointer to copy routine */
+              );
+
+/**
+ * Set the number of freed vectors kept for reuse when a copy routine is set
+ * (see braid_SetCopy).  Pooled vectors count as live user vectors, so this
+ * trades memory for fewer Clone and Free calls.  A size of 0 turns the pool
+ * off.  Default is 4.
+ **/
+braid_Int
+braid_SetVectorPool(braid_Core  core,       /**< braid_Core (_braid_Core) struct*/
+                    braid_Int   vpool_max   /**< number of pooled vectors */
+                    );
+
 /**
  * Set print level for XBraid.  This controls how much information is 
  * printed to the XBraid print file (@ref braid_SetPrintFile).
@@ -874,6 +1207,9 @@ braid_SplitCommworld(const MPI_Comm  *comm_world,  /**< Global communicator to s
  * This feature should be used with storage option = -1. It allows the used to keep metadata
  * on all points (including F-points) without storing the all vector everywhere. With these options,
  * the vectors are fully stored on C-points, but only the vector shell is kept on F-points.
+ * The shell stored at a point is created once and kept across iterations, so it is assumed
+ * not to change for that point.  The memory held in full vectors, shells and communication
+ * buffers on each level is reported in @ref braid_PrintStats.
  **/
 braid_Int
 braid_SetShell(braid_Core          core, 
@@ -911,6 +1247,52 @@ braid_GetNLevels(braid_Core  core,          /**< braid_Core (_braid_Core) struct
                  braid_Int  *nlevels_ptr    /**< output, holds the number of XBraid levels */
                  );
 
+/** \defgroup braidcallmacros XBraid user callback counters
+ *  \ingroup userinterface
+ * Indices into the array returned by braid_GetCallCounts.  The shell routines
+ * SInit and SClone are counted with Init and Clone.
+ *  @{
+ */
+#define braid_Call_Init        0
+#define braid_Call_Clone       1
+#define braid_Call_Copy        2
+#define braid_Call_Free        3
+#define braid_Call_Sum         4
+#define braid_Call_SpatialNorm 5
+#define braid_Call_BufPack     6
+#define braid_Call_BufUnpack   7
+#define braid_Call_Step        8
+#define braid_Call_SCoarsen    9
+#define braid_Call_SRefine     10
+/** Number of counted user callbacks */
+#define braid_NCalls           11
+/** @}*/
+
+/**
+ * Return the number of calls to each user callback made by this processor on
+ * *level* so far, indexed by braid_Call_Init, braid_Call_Clone, etc.  A call
+ * is charged to the level of the vector it creates or updates, e.g., the
+ * coarse-grid vectors made in restriction are counted on the coarse level and
+ * the fine-grid corrections made in interpolation on the fine level.  The
+ * array *counts* must hold braid_NCalls values.
+ **/
+braid_Int
+braid_GetCallCounts(braid_Core  core,          /**< braid_Core (_braid_Core) struct*/
+                    braid_Int   level,         /**< level to query */
+                    braid_Int  *counts         /**< output, braid_NCalls callback counts */
+                    );
+
+/**
+ * Return the number of user vectors currently held by this processor and the
+ * peak number held so far.  Vectors are counted from the callbacks that
+ * create (Init, Clone, BufUnpack, SCoarsen, SRefine) and free them.
+ **/
+braid_Int
+braid_GetNVectors(braid_Core  core,          /**< braid_Core (_braid_Core) struct*/
+                  braid_Int  *nlive_ptr,     /**< output, number of live user vectors */
+                  braid_Int  *npeak_ptr      /**< output, peak number of live user vectors */
+                  );
+
 /** Example function to compute a tapered stopping tolerance for implicit time
  * stepping routines, i.e., a tolerance *tol_ptr* for the spatial solves.  This
  * tapering only occurs on the fine grid.
@@ -1101,6 +1483,20 @@ braid_Int
 braid_GetRNormAdjoint(braid_Core  core,        /**< braid_Core struct */
                       braid_Real  *rnorm_adj   /**< output: adjoint residual norm of last iteration */
                      );
+
+/**
+ * Set the (optional) zero-initialization routine for adjoint vectors, see
+ * @ref braid_PtFcnInitZero.  Bar vectors are always created lazily: a bar
+ * holds no user vector until a differentiated action first writes to it, and
+ * bars that are never written are freed without ever being allocated.  This
+ * routine is then used to allocate the zero vector instead of *Init()* plus
+ * *Sum()*.  Default is no zero-initialization routine.
+ **/
+braid_Int
+braid_SetInitZero(braid_Core           core,       /**< braid_Core (_braid_Core) struct*/
+                  braid_PtFcnInitZero  init_zero   /**< function pointer to zero-initialization routine */
+                  );
+
 /** @}*/
 
 #ifdef __cplusplus
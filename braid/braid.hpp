@@ -498,6 +498,9 @@ public:
    void SetNRelax(braid_Int level, braid_Int nrelax)
    { braid_SetNRelax(core, level, nrelax); }
 
+   void SetRelaxSchedule(braid_Int level, const char *schedule)
+   { braid_SetRelaxSchedule(core, level, schedule); }
+
    void SetAbsTol(braid_Real tol) { braid_SetAbsTol(core, tol); }
 
    void SetRelTol(braid_Real tol) { braid_SetRelTol(core, tol); }
@@ -552,8 +555,28 @@ public:
 
    void SetNFMGVcyc(braid_Int nfmg_Vcyc) { braid_SetNFMGVcyc(core, nfmg_Vcyc); }
 
+   void SetCycle(braid_Int cycle) { braid_SetCycle(core, cycle); }
+
+   void SetNCycles(braid_Int level, braid_Int ncycles) { braid_SetNCycles(core, level, ncycles); }
+
    void SetStorage(braid_Int storage) { braid_SetStorage(core, storage); }
 
+   void SetReducedStorage(braid_Int level) { braid_SetReducedStorage(core, level); }
+
+   void SetOutOfCore(const char *path, braid_Int window) { braid_SetOutOfCore(core, path, window); }
+
+   void SetDeltaStorage(braid_Int keyframe) { braid_SetDeltaStorage(core, keyframe, NULL, NULL); }
+
+   void SetPersistentComm(braid_Int persistent_comm) { braid_SetPersistentComm(core, persistent_comm); }
+
+   void SetCommAggregate(braid_Int comm_agg) { braid_SetCommAggregate(core, comm_agg); }
+
+   void SetShmComm(braid_Int shm) { braid_SetShmComm(core, shm); }
+
+   void SetThreadSafe(braid_Int thread_safe) { braid_SetThreadSafe(core, thread_safe); }
+
+   void SetCompression(braid_Int method, braid_Real tol) { braid_SetCompression(core, method, tol); }
+
    void SetRefine(braid_Int refine) {braid_SetRefine(core, refine);}
 
    void SetMaxRefinements(braid_Int max_refinements) {braid_SetMaxRefinements(core, max_refinements);}
@@ -564,6 +587,10 @@ public:
    
    void GetNLevels(braid_Int *nlevels_ptr) { braid_GetNLevels(core, nlevels_ptr); }
 
+   void GetCallCounts(braid_Int level, braid_Int *counts) { braid_GetCallCounts(core, level, counts); }
+
+   void GetNVectors(braid_Int *nlive_ptr, braid_Int *npeak_ptr) { braid_GetNVectors(core, nlive_ptr, npeak_ptr); }
+
    void Drive() { braid_Drive(core); }
 
    ~BraidCore() { braid_Destroy(core); }
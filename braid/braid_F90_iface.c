@@ -1110,6 +1110,25 @@ braid_F90_Name(braid_set_nrelax_f90, BRAID_SET_NRELAX_F90)(
    return 0;
 }
 
+/* braid_SetRelaxSchedule( )
+ *
+ * User advice: Null-terminate the string schedule in your Fortran code, e.g.,
+ * "FCF"//char(0)
+*/
+braid_Int
+braid_F90_Name(braid_set_relax_schedule_f90, BRAID_SET_RELAX_SCHEDULE_F90)(
+                   braid_F90_ObjPtr  *core,        /**< braid_Core (_braid_Core) struct*/
+                   braid_F90_Int     *level,       /**< *level* to set the schedule on */
+                   char              *schedule,    /**< string of F- and C-sweeps */
+                   braid_F90_Int     *ll           /**< string length */
+                   )
+{
+   braid_SetRelaxSchedule(braid_TakeF90_ObjDeref(braid_Core,  core) ,
+                          braid_TakeF90_Int(                  level),
+                                                              schedule);
+   return 0;
+}
+
 /* braid_SetCFactor( ) */
 braid_Int
 braid_F90_Name(braid_set_cfactor_f90, BRAID_SET_CFACTOR_F90)(
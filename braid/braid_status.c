@@ -68,6 +68,16 @@ _braid_StatusDestroy(braid_Status status)
    return _braid_error_flag;
 }
 
+braid_Int
+_braid_StatusInit(braid_Core    core,
+                  braid_Status  status)
+{
+   memset(status, 0, sizeof(_braid_Status));
+   _braid_StatusElt(status, core) = core;
+
+   return _braid_error_flag;
+}
+
 /*--------------------------------------------------------------------------
  * Status Routines
  *--------------------------------------------------------------------------*/
@@ -113,7 +123,7 @@ braid_StatusGetNLevels(braid_Status status,
                        braid_Int   *nlevels_ptr
                        )
 {
-   *nlevels_ptr = _braid_StatusElt(status, nlevels);
+   *nlevels_ptr = _braid_StatusCoreElt(status, nlevels);
    return _braid_error_flag;
 }
 
@@ -159,7 +169,7 @@ braid_StatusGetTIUL(braid_Status status,
                     braid_Int    level
                     )
 {
-   _braid_Grid **grids = _braid_StatusElt(status, grids);
+   _braid_Grid **grids = _braid_StatusCoreElt(status, grids);
 
    *iloc_upper = _braid_GridElt(grids[level], iupper);
    *iloc_lower = _braid_GridElt(grids[level], ilower);
@@ -177,7 +187,7 @@ braid_StatusGetTimeValues(braid_Status status,
    /* We assume user has allocated enough space in tvalues_ptr */
    braid_Int iloc_lower, cpy_lower, cpy_size;
    braid_Real *ta;
-   _braid_Grid **grids = _braid_StatusElt(status, grids);
+   _braid_Grid **grids = _braid_StatusCoreElt(status, grids);
    iloc_lower = _braid_GridElt(grids[level], ilower);
    ta = _braid_GridElt(grids[level], ta);
 
@@ -309,7 +319,7 @@ braid_StatusGetRNorms(braid_Status status,
                       braid_Real  *rnorms_ptr
                       )
 {
-   braid_Real *_rnorms    = _braid_StatusElt(status, rnorms);
+   braid_Real *_rnorms    = _braid_StatusCoreElt(status, rnorms);
    braid_Int   rnorms_len = _braid_StatusElt(status, niter) + 1;
 
    _braid_GetNEntries(_rnorms, rnorms_len, nrequest_ptr, rnorms_ptr);
@@ -353,8 +363,8 @@ braid_StatusSetRFactor(braid_Status status,
    /* Only set the rfactor on level 0 */
    if (level == 0)
    {
-      _braid_Grid      **grids    = _braid_StatusElt(status, grids);
-      braid_Int         *rfactors = _braid_StatusElt(status, rfactors);
+      _braid_Grid      **grids    = _braid_StatusCoreElt(status, grids);
+      braid_Int         *rfactors = _braid_StatusCoreElt(status, rfactors);
       braid_Int          index    = _braid_StatusElt(status, idx);
       braid_Int          ilower   = _braid_GridElt(grids[level], ilower);
       braid_Int          ii       = index+1 - ilower;
@@ -377,8 +387,8 @@ braid_StatusSetRefinementDtValues(braid_Status  status,
    /* Only set the rfactor on level 0 */
    if (level == 0)
    {
-      _braid_Grid      **grids    = _braid_StatusElt(status, grids);
-      braid_Int         *rfactors = _braid_StatusElt(status, rfactors);
+      _braid_Grid      **grids    = _braid_StatusCoreElt(status, grids);
+      braid_Int         *rfactors = _braid_StatusCoreElt(status, rfactors);
       braid_Int          index    = _braid_StatusElt(status, idx);
       braid_Int          ilower   = _braid_GridElt(grids[level], ilower);
       braid_Int          ii       = index+1 - ilower;
@@ -389,7 +399,7 @@ braid_StatusSetRefinementDtValues(braid_Status  status,
       /* Store dt values */
       if (rfactor > 1)
       {
-         braid_Real  **rdtvalues = _braid_StatusElt(status, rdtvalues);
+         braid_Real  **rdtvalues = _braid_StatusCoreElt(status, rdtvalues);
          braid_Int     j;
 
          if (rdtvalues[ii] != NULL)
@@ -579,6 +589,31 @@ _braid_StepStatusInit(braid_Real       tstart,
    _braid_StatusElt(status, gupper)    = gupper;
    _braid_StatusElt(status, r_space)   = 0;
 
+   /* Start from the tolx values of the previous step, if there is a core */
+   if (_braid_StatusElt(status, core) != NULL)
+   {
+      _braid_StatusElt(status, old_fine_tolx)   = _braid_StatusCoreElt(status, old_fine_tolx);
+      _braid_StatusElt(status, tight_fine_tolx) = _braid_StatusCoreElt(status, tight_fine_tolx);
+   }
+   else
+   {
+      _braid_StatusElt(status, old_fine_tolx)   = -1.0;
+      _braid_StatusElt(status, tight_fine_tolx) = 1;
+   }
+
+   return _braid_error_flag;
+}
+
+braid_Int
+_braid_StepStatusDone(braid_StepStatus status)
+{
+   if (_braid_StatusElt(status, core) != NULL)
+   {
+      _braid_StatusCoreElt(status, old_fine_tolx)   = _braid_StatusElt(status, old_fine_tolx);
+      _braid_StatusCoreElt(status, tight_fine_tolx) = _braid_StatusElt(status, tight_fine_tolx);
+      _braid_StatusCoreElt(status, r_space)         = _braid_StatusElt(status, r_space);
+   }
+
    return _braid_error_flag;
 }
 ACCESSOR_FUNCTION_GET1(Step, T,             Real)
@@ -666,11 +666,11 @@ braid_TestResidual( braid_App              app,
    /* 
     * Next, we must initialize status so that the user may call
     * braid_StepStatusSetRFactor() from inside of step(), which many users will
-    * do.  Calling braid_StepStatusSetRFactor() requires that status (which is
-    * really a braid_Core) to have allocated two pieces of data, 
+    * do.  Calling braid_StepStatusSetRFactor() requires that the core behind
+    * status has allocated two pieces of data, 
     * (1) core->rfactors and (2) core->grids[0]->ilower
     */
-   braid_Core              core    = (braid_Core) status;
+   braid_Core              core    = _braid_CTAlloc(_braid_Core, 1);
    _braid_Grid          **grids    = _braid_CoreElt(core, grids);
    braid_Int              *rfactors;
    _braid_Grid            *fine_grid;
@@ -684,6 +684,7 @@ braid_TestResidual( braid_App              app,
    rfactors = _braid_CTAlloc(braid_Int, 4); 
    _braid_CoreElt(core, rfactors) = rfactors;
 
+   _braid_StatusInit(core, status);
    _braid_StepStatusInit(t, t+dt, 0, 1e-16, 0, 0, 0, 2, sstatus);
    _braid_AccessStatusInit(t, 0, 0.0, 0, 0, 0, 2, 0, 1, -1, astatus);
 
@@ -770,6 +771,7 @@ braid_TestResidual( braid_App              app,
    _braid_TFree(rfactors);
    _braid_TFree(grids);
    _braid_TFree(fine_grid);
+   _braid_TFree(core);
 
    _braid_ParFprintfFlush(fp, myid_x, "Finished braid_TestResidual \n");
    
@@ -22,6 +22,238 @@
 #include "_braid.h"
 #include "util.h"
 
+/*----------------------------------------------------------------------------
+ * Zero-copy messages are used when the user provides a buffer view.  They are
+ * not used for adjoint runs (BufPack and BufUnpack are recorded on the tape)
+ * or with spatial coarsening (receive vectors are created with Init).
+ *----------------------------------------------------------------------------*/
+
+static braid_Int
+_braid_CommZeroCopy(braid_Core  core)
+{
+   return ( (_braid_CoreElt(core, bufview) != NULL) &&
+            !_braid_CoreElt(core, adjoint) &&
+            (_braid_CoreElt(core, scoarsen) == NULL) );
+}
+
+/*----------------------------------------------------------------------------
+ * Compressed messages have a variable length, so they do not use the
+ * persistent requests.  Zero-copy and aggregated messages are not compressed.
+ *----------------------------------------------------------------------------*/
+
+static braid_Int
+_braid_CommCompressing(braid_Core  core)
+{
+   return ( (_braid_CoreElt(core, compress) != braid_COMPRESS_NONE) &&
+            !_braid_CoreElt(core, adjoint) );
+}
+
+/*----------------------------------------------------------------------------
+ * Messages are tagged by level and communication phase, so each phase on each
+ * level is a separate epoch and receives for one phase never match sends from
+ * another.  Tags below _braid_TagBase are left to FRefine.
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_CommTag(braid_Core   core,
+               braid_Int    level,
+               braid_Int   *tag_ptr)
+{
+   *tag_ptr = _braid_TagBase + level*_braid_NPhases + _braid_CoreElt(core, comm_phase);
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ * Pop a handle off the comm pool for this level, growing its buffer if needed.
+ * A new handle is only allocated when all pooled handles are in flight.
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_CommHandleGet(braid_Core           core,
+                     braid_Int            level,
+                     braid_Int            size,
+                     _braid_CommHandle  **handle_ptr)
+{
+   _braid_Grid        *grid   = _braid_CoreElt(core, grids)[level];
+   _braid_CommHandle  *handle = _braid_GridElt(grid, comm_pool);
+
+   if (handle != NULL)
+   {
+      _braid_GridElt(grid, comm_pool) = _braid_CommHandleElt(handle, next);
+   }
+   else
+   {
+      handle = _braid_CTAlloc(_braid_CommHandle, 1);
+      _braid_CommHandleElt(handle, num_requests) = 1;
+      _braid_CommHandleElt(handle, requests) = _braid_CTAlloc(MPI_Request, 1);
+      _braid_CommHandleElt(handle, status)   = _braid_CTAlloc(MPI_Status, 1);
+      _braid_CommHandleElt(handle, level)    = level;
+   }
+
+   /* Buffers only grow, so steady-state messages do not allocate */
+   if (size > _braid_CommHandleElt(handle, buffer_size))
+   {
+      free(_braid_CommHandleElt(handle, buffer));
+      _braid_CommHandleElt(handle, buffer)      = malloc(size);
+      _braid_CommHandleElt(handle, buffer_size) = size;
+   }
+   _braid_CommHandleElt(handle, vector_ptr) = NULL;
+   _braid_CommHandleElt(handle, vector)     = NULL;
+   _braid_CommHandleElt(handle, user_vector) = NULL;
+   _braid_CommHandleElt(handle, nvectors)   = 0;
+   _braid_CommHandleElt(handle, npacked)    = 0;
+   _braid_CommHandleElt(handle, shm_slot)   = NULL;
+   _braid_CommHandleElt(handle, phase)      = 0;
+   _braid_CommHandleElt(handle, next)       = NULL;
+
+   *handle_ptr = handle;
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ * Persistent handles are kept out of the comm pool and hold one request per
+ * communication phase
+ *----------------------------------------------------------------------------*/
+
+static braid_Int
+_braid_CommPersistentHandle(braid_Core           core,
+                            braid_Int            level,
+                            braid_Int            size,
+                            _braid_CommHandle  **handle_ptr)
+{
+   _braid_CommHandle  *handle;
+
+   handle = _braid_CTAlloc(_braid_CommHandle, 1);
+   _braid_CommHandleElt(handle, num_requests) = 1;
+   _braid_CommHandleElt(handle, requests)     = _braid_CTAlloc(MPI_Request, _braid_NPhases);
+   _braid_CommHandleElt(handle, status)       = _braid_CTAlloc(MPI_Status, 1);
+   _braid_CommHandleElt(handle, buffer)       = malloc(size);
+   _braid_CommHandleElt(handle, buffer_size)  = size;
+   _braid_CommHandleElt(handle, level)        = level;
+   _braid_CommHandleElt(handle, persistent)   = 1;
+
+   *handle_ptr = handle;
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_CommPersistentInit(braid_Core  core,
+                          braid_Int   level)
+{
+   MPI_Comm            comm    = _braid_CoreElt(core, comm);
+   braid_App           app     = _braid_CoreElt(core, app);
+   _braid_Grid        *grid    = _braid_CoreElt(core, grids)[level];
+   braid_Int           ilower  = _braid_GridElt(grid, ilower);
+   braid_Int           iupper  = _braid_GridElt(grid, iupper);
+   _braid_CommHandle  *handle;
+   braid_Int           proc, size, phase;
+   _braid_BufferStatus bstatus_s;
+   braid_BufferStatus  bstatus = &bstatus_s;
+
+   _braid_StatusInit(core, (braid_Status) bstatus);
+
+   if ( (ilower > iupper) || _braid_CommCompressing(core) )
+   {
+      return _braid_error_flag;
+   }
+
+   /* The persistent requests always move a full BufSize message */
+   _braid_BufferStatusInit( 0, 0, bstatus );
+   _braid_BaseBufSize(core, app,  &size, bstatus);
+
+   /* Each phase has its own tag, so set up one request per phase.  They all
+    * share the handle buffer, since only one can be active at a time. */
+   _braid_GetProc(core, level, ilower-1, &proc);
+   if (proc > -1)
+   {
+      _braid_CommPersistentHandle(core, level, size, &handle);
+      for (phase = 0; phase < _braid_NPhases; phase++)
+      {
+         MPI_Recv_init(_braid_CommHandleElt(handle, buffer), size, MPI_BYTE, proc,
+                       _braid_TagBase + level*_braid_NPhases + phase, comm,
+                       &_braid_CommHandleElt(handle, requests)[phase]);
+      }
+      _braid_CommHandleElt(handle, request_type) = 1; /* recv type = 1 */
+      _braid_GridElt(grid, recv_persist) = handle;
+   }
+
+   _braid_GetProc(core, level, iupper+1, &proc);
+   if (proc > -1)
+   {
+      _braid_CommPersistentHandle(core, level, size, &handle);
+      for (phase = 0; phase < _braid_NPhases; phase++)
+      {
+         MPI_Send_init(_braid_CommHandleElt(handle, buffer), size, MPI_BYTE, proc,
+                       _braid_TagBase + level*_braid_NPhases + phase, comm,
+                       &_braid_CommHandleElt(handle, requests)[phase]);
+      }
+      _braid_CommHandleElt(handle, request_type) = 0; /* send type = 0 */
+      _braid_GridElt(grid, send_persist) = handle;
+   }
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ *----------------------------------------------------------------------------*/
+
+static braid_Int
+_braid_CommHandleDestroy(_braid_CommHandle  *handle)
+{
+   braid_Int  phase;
+
+   if (_braid_CommHandleElt(handle, persistent))
+   {
+      for (phase = 0; phase < _braid_NPhases; phase++)
+      {
+         MPI_Request_free(&_braid_CommHandleElt(handle, requests)[phase]);
+      }
+   }
+   _braid_TFree(_braid_CommHandleElt(handle, requests));
+   _braid_TFree(_braid_CommHandleElt(handle, status));
+   free(_braid_CommHandleElt(handle, buffer));
+   _braid_TFree(handle);
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_CommPoolDestroy(_braid_Grid  *grid)
+{
+   _braid_CommHandle  *handle = _braid_GridElt(grid, comm_pool);
+   _braid_CommHandle  *next;
+
+   while (handle != NULL)
+   {
+      next = _braid_CommHandleElt(handle, next);
+      _braid_CommHandleDestroy(handle);
+      handle = next;
+   }
+   _braid_GridElt(grid, comm_pool) = NULL;
+
+   if (_braid_GridElt(grid, recv_persist) != NULL)
+   {
+      _braid_CommHandleDestroy(_braid_GridElt(grid, recv_persist));
+      _braid_GridElt(grid, recv_persist) = NULL;
+   }
+   if (_braid_GridElt(grid, send_persist) != NULL)
+   {
+      _braid_CommHandleDestroy(_braid_GridElt(grid, send_persist));
+      _braid_GridElt(grid, send_persist) = NULL;
+   }
+
+   return _braid_error_flag;
+}
+
 /*----------------------------------------------------------------------------
  *----------------------------------------------------------------------------*/
 
@@ -34,35 +266,91 @@ _braid_CommRecvInit(braid_Core           core,
 {
    MPI_Comm            comm = _braid_CoreElt(core, comm);
    braid_App           app  = _braid_CoreElt(core, app);
-   _braid_CommHandle  *handle = NULL;
-   void               *buffer;
-   MPI_Request        *requests;
-   MPI_Status         *status;
-   braid_Int           proc, size, num_requests;
-   braid_BufferStatus bstatus = (braid_BufferStatus)core;
+   _braid_Grid        *grid = _braid_CoreElt(core, grids)[level];
+   _braid_CommHandle  *handle = _braid_GridElt(grid, recv_persist);
+   braid_Real         *ta   = _braid_GridElt(grid, ta);
+   braid_BaseVector    vector;
+   void               *data, *slot;
+   braid_Int           proc, size, shm, tag;
+   _braid_BufferStatus bstatus_s;
+   braid_BufferStatus  bstatus = &bstatus_s;
+
+   _braid_StatusInit(core, (braid_Status) bstatus);
 
    _braid_GetProc(core, level, index, &proc);
-   if (proc > -1)
-   {
-      handle = _braid_TAlloc(_braid_CommHandle, 1);
+   _braid_CommTag(core, level, &tag);
 
-      /* Allocate buffer through user routine */
+   /* The left neighbor writes into our shared-memory slot if on this node */
+   shm = 0;
+   if ( (proc > -1) && (_braid_GridElt(grid, shm_recv) != NULL) &&
+        (index == _braid_GridElt(grid, ilower)-1) )
+   {
       _braid_BufferStatusInit( 0, 0, bstatus );
       _braid_BaseBufSize(core, app,  &size, bstatus);
-      buffer = malloc(size);
-
-      num_requests = 1;
-      requests = _braid_CTAlloc(MPI_Request, num_requests);
-      status   = _braid_CTAlloc(MPI_Status, num_requests);
-      MPI_Irecv(buffer, size, MPI_BYTE, proc, 0, comm, &requests[0]);
+      _braid_ShmFits(core, size, &shm);
+   }
 
+   if (shm)
+   {
+      _braid_ShmNextSlot(core, level, 1, &slot);
+      _braid_CommHandleGet(core, level, 0, &handle);
+      _braid_CommHandleElt(handle, request_type) = 1; /* recv type = 1 */
+      _braid_CommHandleElt(handle, shm_slot)     = slot;
+      _braid_CommHandleElt(handle, vector_ptr)   = vector_ptr;
+   }
+   else if ( (proc > -1) && _braid_CommZeroCopy(core) )
+   {
+      /* Receive directly into a recycled vector if there is one (its data is
+       * overwritten, so no Init or BufUnpack is needed), or else a new one */
+      vector = NULL;
+      if (_braid_BasePoolOn(core))
+      {
+         _braid_BasePoolGet(core, 0, &vector);
+      }
+      if (vector == NULL)
+      {
+         _braid_BaseInit(core, app, ta[index-_braid_GridElt(grid, ilower)], &vector);
+      }
+      _braid_BaseBufView(core, app, vector, &data, &size);
+      _braid_CommHandleGet(core, level, 0, &handle);
+      MPI_Irecv(data, size, MPI_BYTE, proc, tag, comm,
+                &_braid_CommHandleElt(handle, requests)[0]);
       _braid_CommHandleElt(handle, request_type) = 1; /* recv type = 1 */
-      _braid_CommHandleElt(handle, num_requests) = num_requests;
-      _braid_CommHandleElt(handle, requests)     = requests;
-      _braid_CommHandleElt(handle, status)       = status;
-      _braid_CommHandleElt(handle, buffer)       = buffer;
+      _braid_CommHandleElt(handle, vector)       = vector;
       _braid_CommHandleElt(handle, vector_ptr)   = vector_ptr;
    }
+   else if (proc > -1)
+   {
+      /* Get buffer size through user routine */
+      _braid_BufferStatusInit( 0, 0, bstatus );
+      _braid_BaseBufSize(core, app,  &size, bstatus);
+      if (_braid_CommCompressing(core))
+      {
+         _braid_CompressBound(size, &size);
+      }
+
+      /* Use the persistent request for the usual left-neighbor receive */
+      if ( (handle != NULL) && (index == _braid_GridElt(grid, ilower)-1) &&
+           !_braid_CommHandleElt(handle, active) &&
+           (size <= _braid_CommHandleElt(handle, buffer_size)) )
+      {
+         _braid_CommHandleElt(handle, phase) = _braid_CoreElt(core, comm_phase);
+         MPI_Startall(1, &_braid_CommHandleElt(handle, requests)[_braid_CommHandleElt(handle, phase)]);
+         _braid_CommHandleElt(handle, active) = 1;
+      }
+      else
+      {
+         _braid_CommHandleGet(core, level, size, &handle);
+         MPI_Irecv(_braid_CommHandleElt(handle, buffer), size, MPI_BYTE, proc, tag, comm,
+                   &_braid_CommHandleElt(handle, requests)[0]);
+         _braid_CommHandleElt(handle, request_type) = 1; /* recv type = 1 */
+      }
+      _braid_CommHandleElt(handle, vector_ptr) = vector_ptr;
+   }
+   else
+   {
+      handle = NULL;
+   }
 
    *handle_ptr = handle;
 
@@ -81,23 +369,79 @@ _braid_CommSendInit(braid_Core           core,
 {
    MPI_Comm            comm = _braid_CoreElt(core, comm);
    braid_App           app  = _braid_CoreElt(core, app);
-   _braid_CommHandle  *handle = NULL;
-   void               *buffer;
-   MPI_Request        *requests;
-   MPI_Status         *status;
-   braid_Int           proc, size, num_requests;
-   braid_BufferStatus  bstatus   = (braid_BufferStatus)core;
+   _braid_Grid        *grid = _braid_CoreElt(core, grids)[level];
+   _braid_CommHandle  *handle = _braid_GridElt(grid, send_persist);
+   void               *data, *buffer, *slot;
+   braid_Int           proc, size, persistent, compressing, shm, tag;
+   _braid_BufferStatus bstatus_s;
+   braid_BufferStatus  bstatus   = &bstatus_s;
+
+   _braid_StatusInit(core, (braid_Status) bstatus);
    
 
    _braid_GetProc(core, level, index+1, &proc);
-   if (proc > -1)
+   _braid_CommTag(core, level, &tag);
+
+   /* Pack straight into the right neighbor's shared-memory slot if on this node */
+   shm = 0;
+   if ( (proc > -1) && (_braid_GridElt(grid, shm_send) != NULL) &&
+        (index == _braid_GridElt(grid, iupper)) )
    {
-      handle = _braid_TAlloc(_braid_CommHandle, 1);
+      _braid_BufferStatusInit( 0, 0, bstatus );
+      _braid_BaseBufSize(core, app,  &size, bstatus);
+      _braid_ShmFits(core, size, &shm);
+   }
 
-      /* Allocate buffer through user routine */
+   if (shm)
+   {
+      _braid_ShmNextSlot(core, level, 0, &slot);
+      _braid_ShmSend(core, slot, proc, vector);
+      handle = NULL;
+   }
+   else if ( (proc > -1) && _braid_CommZeroCopy(core) )
+   {
+      /* Send directly from vector memory, no BufPack needed.  The handle
+       * references the vector until the send completes, and a vector that is
+       * overwritten or freed before then leaves its data to the handle (see
+       * _braid_CommRelease). */
+      if (vector->send != NULL)
+      {
+         _braid_CommRelease(core, vector, 1);
+      }
+      _braid_CommHandleGet(core, level, 0, &handle);
+      _braid_BaseBufView(core, app, vector, &data, &size);
+      MPI_Isend(data, size, MPI_BYTE, proc, tag, comm,
+                &_braid_CommHandleElt(handle, requests)[0]);
+      _braid_CommHandleElt(handle, request_type) = 0; /* send type = 0 */
+      _braid_CommHandleElt(handle, vector)       = vector;
+      vector->send = handle;
+   }
+   else if (proc > -1)
+   {
+      /* Get buffer size through user routine */
       _braid_BufferStatusInit( 0, 0, bstatus );
       _braid_BaseBufSize(core, app,  &size, bstatus);
-      buffer = malloc(size);
+
+      /* Pack into scratch memory first if the message is compressed */
+      compressing = _braid_CommCompressing(core);
+      if (compressing)
+      {
+         _braid_CompressScratch(core, size, &buffer);
+         _braid_CompressBound(size, &size);
+      }
+
+      /* Use the persistent request for the usual right-neighbor send */
+      persistent = ( (handle != NULL) && (index == _braid_GridElt(grid, iupper)) &&
+                     !_braid_CommHandleElt(handle, active) &&
+                     (size <= _braid_CommHandleElt(handle, buffer_size)) );
+      if (!persistent)
+      {
+         _braid_CommHandleGet(core, level, size, &handle);
+      }
+      if (!compressing)
+      {
+         buffer = _braid_CommHandleElt(handle, buffer);
+      }
 
       /* Store the receiver rank in the status */
       _braid_StatusElt(bstatus, send_recv_rank) = proc;
@@ -107,16 +451,121 @@ _braid_CommSendInit(braid_Core           core,
       _braid_BaseBufPack(core, app,  vector, buffer, bstatus);
       size = _braid_StatusElt( bstatus, size_buffer );
 
-      num_requests = 1;
-      requests = _braid_CTAlloc(MPI_Request, num_requests);
-      status   = _braid_CTAlloc(MPI_Status, num_requests);
-      MPI_Isend(buffer, size, MPI_BYTE, proc, 0, comm, &requests[0]);
+      if (compressing)
+      {
+         _braid_Compress(core, buffer, size, _braid_CommHandleElt(handle, buffer), &size);
+      }
+
+      if (persistent)
+      {
+         _braid_CommHandleElt(handle, phase) = _braid_CoreElt(core, comm_phase);
+         MPI_Startall(1, &_braid_CommHandleElt(handle, requests)[_braid_CommHandleElt(handle, phase)]);
+         _braid_CommHandleElt(handle, active) = 1;
+      }
+      else
+      {
+         MPI_Isend(_braid_CommHandleElt(handle, buffer), size, MPI_BYTE, proc, tag, comm,
+                   &_braid_CommHandleElt(handle, requests)[0]);
+         _braid_CommHandleElt(handle, request_type) = 0; /* send type = 0 */
+      }
+   }
+   else
+   {
+      handle = NULL;
+   }
+
+   *handle_ptr = handle;
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ * Aggregated messages hold a header with the vector count, followed by one
+ * BufSize slot per vector (rounded up to keep the slots aligned).
+ *----------------------------------------------------------------------------*/
+
+static braid_Int
+_braid_CommAggSlotSize(braid_Core  core)
+{
+   braid_App           app     = _braid_CoreElt(core, app);
+   _braid_BufferStatus bstatus_s;
+   braid_BufferStatus  bstatus = &bstatus_s;
+   braid_Int           size;
+
+   _braid_StatusInit(core, (braid_Status) bstatus);
+
+   _braid_BufferStatusInit( 0, 0, bstatus );
+   _braid_BaseBufSize(core, app,  &size, bstatus);
+
+   return _braid_CommAggHeader*((size + _braid_CommAggHeader - 1)/_braid_CommAggHeader);
+}
+
+/*----------------------------------------------------------------------------
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_CommRecvInitAgg(braid_Core           core,
+                       braid_Int            level,
+                       braid_Int            index,
+                       braid_Int            nvectors,
+                       braid_BaseVector   **vector_ptrs,
+                       _braid_CommHandle  **handle_ptr)
+{
+   MPI_Comm            comm   = _braid_CoreElt(core, comm);
+   _braid_CommHandle  *handle = NULL;
+   braid_Int           proc, slot_size, size, tag, i;
+
+   _braid_GetProc(core, level, index, &proc);
+   _braid_CommTag(core, level, &tag);
+   if (proc > -1)
+   {
+      slot_size = _braid_CommAggSlotSize(core);
+      size      = _braid_CommAggHeader + nvectors*slot_size;
+      _braid_CommHandleGet(core, level, size, &handle);
+
+      MPI_Irecv(_braid_CommHandleElt(handle, buffer), size, MPI_BYTE, proc, tag, comm,
+                &_braid_CommHandleElt(handle, requests)[0]);
+
+      _braid_CommHandleElt(handle, request_type) = 1; /* recv type = 1 */
+      _braid_CommHandleElt(handle, nvectors)     = nvectors;
+      _braid_CommHandleElt(handle, slot_size)    = slot_size;
+      for (i = 0; i < nvectors; i++)
+      {
+         _braid_CommHandleElt(handle, agg_ptrs)[i] = vector_ptrs[i];
+      }
+   }
+
+   *handle_ptr = handle;
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_CommSendInitAgg(braid_Core           core,
+                       braid_Int            level,
+                       braid_Int            index,
+                       braid_Int            nvectors,
+                       _braid_CommHandle  **handle_ptr)
+{
+   _braid_CommHandle  *handle = NULL;
+   braid_Int           proc, slot_size;
+
+   _braid_GetProc(core, level, index+1, &proc);
+   if (proc > -1)
+   {
+      slot_size = _braid_CommAggSlotSize(core);
+      _braid_CommHandleGet(core, level, _braid_CommAggHeader + nvectors*slot_size, &handle);
+
+      /* Store the vector count in the message header */
+      *((braid_Int *) _braid_CommHandleElt(handle, buffer)) = nvectors;
 
       _braid_CommHandleElt(handle, request_type) = 0; /* send type = 0 */
-      _braid_CommHandleElt(handle, num_requests) = num_requests;
-      _braid_CommHandleElt(handle, requests)     = requests;
-      _braid_CommHandleElt(handle, status)       = status;
-      _braid_CommHandleElt(handle, buffer)       = buffer;
+      _braid_CommHandleElt(handle, nvectors)     = nvectors;
+      _braid_CommHandleElt(handle, slot_size)    = slot_size;
+      _braid_CommHandleElt(handle, proc)         = proc;
    }
 
    *handle_ptr = handle;
@@ -124,6 +573,206 @@ _braid_CommSendInit(braid_Core           core,
    return _braid_error_flag;
 }
 
+/*----------------------------------------------------------------------------
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_CommSendAppend(braid_Core          core,
+                      _braid_CommHandle  *handle,
+                      braid_Int           slot,
+                      braid_BaseVector    vector)
+{
+   MPI_Comm            comm     = _braid_CoreElt(core, comm);
+   braid_App           app      = _braid_CoreElt(core, app);
+   _braid_BufferStatus bstatus_s;
+   braid_BufferStatus  bstatus  = &bstatus_s;
+   braid_Int           nvectors, slot_size, size, tag, call_level;
+   char               *buffer;
+
+   _braid_StatusInit(core, (braid_Status) bstatus);
+
+   if (handle != NULL)
+   {
+      nvectors  = _braid_CommHandleElt(handle, nvectors);
+      slot_size = _braid_CommHandleElt(handle, slot_size);
+      buffer    = (char *) _braid_CommHandleElt(handle, buffer);
+
+      /* As in _braid_CommFinish, slot > 0 is on the next coarser level */
+      _braid_SetCallLevel(_braid_CommHandleElt(handle, level) + slot, &call_level);
+      _braid_BufferStatusInit( 0, 0, bstatus );
+      _braid_StatusElt(bstatus, send_recv_rank) = _braid_CommHandleElt(handle, proc);
+      _braid_StatusElt(bstatus, size_buffer)    = slot_size;
+      _braid_BaseBufPack(core, app,  vector, buffer + _braid_CommAggHeader + slot*slot_size, bstatus);
+      _braid_SetCallLevel(call_level, NULL);
+
+      /* Post the message once all vectors are packed */
+      _braid_CommHandleElt(handle, npacked) ++;
+      if (_braid_CommHandleElt(handle, npacked) == nvectors)
+      {
+         size = _braid_CommAggHeader + nvectors*slot_size;
+         _braid_CommTag(core, _braid_CommHandleElt(handle, level), &tag);
+         MPI_Isend(buffer, size, MPI_BYTE, _braid_CommHandleElt(handle, proc), tag, comm,
+                   &_braid_CommHandleElt(handle, requests)[0]);
+      }
+   }
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ * A zero-copy send reads the user vector of u in place until it completes.  If
+ * u is about to be overwritten or freed before then, the handle takes over
+ * that user vector and frees it when done, and u gets a clone of it (keep = 1)
+ * or none at all (keep = 0, when freeing).  Usually the send completes first
+ * and nothing is copied.  Vectors may be released on threads both inside and
+ * outside of a _braid_Critical section, so this uses its own lock (critical
+ * sections do not nest).  The user's Clone is therefore not serialized with
+ * the other callbacks, and braid_SetThreadSafe requires it to be thread safe
+ * when a buffer view is set.
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_CommRelease(braid_Core        core,
+                   braid_BaseVector  u,
+                   braid_Int         keep)
+{
+   braid_App           app = _braid_CoreElt(core, app);
+   _braid_CommHandle  *handle;
+
+#ifdef _OPENMP
+#pragma omp critical (braid_send)
+#endif
+   {
+      handle = u->send;
+      if (handle != NULL)
+      {
+         _braid_CommHandleElt(handle, user_vector) = u->userVector;
+         _braid_CommHandleElt(handle, vector)      = NULL;
+         u->send = NULL;
+         if (keep)
+         {
+            _braid_CountFcn(core, clone)(app, _braid_CommHandleElt(handle, user_vector),
+                                         &(u->userVector));
+         }
+         else
+         {
+            u->userVector = NULL;
+         }
+      }
+   }
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ * Finish a completed message: unpack received vectors, unpin vectors read by
+ * zero-copy sends, and return the handle to the comm pool
+ *----------------------------------------------------------------------------*/
+
+static braid_Int
+_braid_CommFinish(braid_Core          core,
+                  _braid_CommHandle  *handle)
+{
+   braid_App           app          = _braid_CoreElt(core, app);
+   braid_Int           request_type = _braid_CommHandleElt(handle, request_type);
+   MPI_Status         *status       = _braid_CommHandleElt(handle, status);
+   void               *buffer       = _braid_CommHandleElt(handle, buffer);
+   braid_Int           level        = _braid_CommHandleElt(handle, level);
+   _braid_Grid        *grid         = _braid_CoreElt(core, grids)[level];
+   braid_Int           nvectors     = _braid_CommHandleElt(handle, nvectors);
+   braid_Int           slot_size    = _braid_CommHandleElt(handle, slot_size);
+   _braid_BufferStatus bstatus_s;
+   braid_BufferStatus  bstatus      = &bstatus_s;
+   braid_Int           i;
+
+   _braid_StatusInit(core, (braid_Status) bstatus);
+
+   if (_braid_CommHandleElt(handle, shm_slot) != NULL)
+   {
+      /* Shared-memory recv, already unpacked by _braid_ShmRecv */
+   }
+   else if ( (request_type == 1) && (nvectors > 0) )
+   {
+      /* Aggregated recv, unpack each vector slot */
+      if (*((braid_Int *) buffer) != nvectors)
+      {
+         _braid_Error(braid_ERROR_GENERIC, "Aggregated message has an unexpected vector count");
+      }
+      for (i = 0; i < nvectors; i++)
+      {
+         braid_Int  call_level;
+
+         /* Slot i > 0 holds the boundary value of the next coarser level (see
+          * _braid_FRestrict), so charge its unpack to that level */
+         _braid_SetCallLevel(level + i, &call_level);
+         _braid_BufferStatusInit( 0, 0, bstatus );
+         _braid_StatusElt(bstatus, send_recv_rank ) = status->MPI_SOURCE;
+         _braid_BaseBufUnpack(core, app, (char *) buffer + _braid_CommAggHeader + i*slot_size,
+                              _braid_CommHandleElt(handle, agg_ptrs)[i], bstatus);
+         _braid_SetCallLevel(call_level, NULL);
+      }
+   }
+   else if ( (request_type == 1) && (_braid_CommHandleElt(handle, vector) != NULL) )
+   {
+      /* Zero-copy recv, the data is already in place */
+      braid_BaseVector  *vector_ptr = _braid_CommHandleElt(handle, vector_ptr);
+
+      *vector_ptr = _braid_CommHandleElt(handle, vector);
+      _braid_CommHandleElt(handle, vector) = NULL;
+   }
+   else if (request_type == 1) /* recv type */
+   {
+      _braid_BufferStatusInit( 0, 0, bstatus );
+      braid_BaseVector  *vector_ptr = _braid_CommHandleElt(handle, vector_ptr);
+      
+      /* Store the sender rank the bufferStatus */   
+      _braid_StatusElt(bstatus, send_recv_rank ) = status->MPI_SOURCE;
+
+      if (_braid_CommCompressing(core))
+      {
+         braid_Int  size;
+
+         _braid_Decompress(core, buffer, &buffer, &size);
+      }
+      
+      _braid_BaseBufUnpack(core, app,  buffer, vector_ptr, bstatus);
+   }
+   else
+   {
+      /* A zero-copy send has completed, so unpin its vector, or free the user
+       * vector it took over */
+#ifdef _OPENMP
+#pragma omp critical (braid_send)
+#endif
+      {
+         if (_braid_CommHandleElt(handle, vector) != NULL)
+         {
+            _braid_CommHandleElt(handle, vector)->send = NULL;
+            _braid_CommHandleElt(handle, vector) = NULL;
+         }
+         if (_braid_CommHandleElt(handle, user_vector) != NULL)
+         {
+            _braid_CountFcn(core, free)(app, _braid_CommHandleElt(handle, user_vector));
+            _braid_CommHandleElt(handle, user_vector) = NULL;
+         }
+      }
+   }
+   
+   if (_braid_CommHandleElt(handle, persistent))
+   {
+      /* Persistent requests stay attached to the grid */
+      _braid_CommHandleElt(handle, active) = 0;
+   }
+   else
+   {
+      /* Return the handle (and its buffer) to the comm pool for this level */
+      _braid_CommHandleElt(handle, next) = _braid_GridElt(grid, comm_pool);
+      _braid_GridElt(grid, comm_pool)    = handle;
+   }
+
+   return _braid_error_flag;
+}
+
 /*----------------------------------------------------------------------------
  *----------------------------------------------------------------------------*/
 
@@ -131,35 +780,46 @@ braid_Int
 _braid_CommWait(braid_Core          core,
                 _braid_CommHandle **handle_ptr)
 {
-   braid_App           app    = _braid_CoreElt(core, app);
    _braid_CommHandle  *handle = *handle_ptr;
 
    if (handle != NULL)
    {
       braid_Int      request_type = _braid_CommHandleElt(handle, request_type);
       braid_Int      num_requests = _braid_CommHandleElt(handle, num_requests);
-      MPI_Request   *requests     = _braid_CommHandleElt(handle, requests);
+      MPI_Request   *requests     = _braid_CommHandleElt(handle, requests) +
+                                    _braid_CommHandleElt(handle, phase);
       MPI_Status    *status       = _braid_CommHandleElt(handle, status);
-      void          *buffer       = _braid_CommHandleElt(handle, buffer);
-      braid_BufferStatus bstatus  = (braid_BufferStatus)core;
+      braid_Int      level        = _braid_CommHandleElt(handle, level);
+      braid_Int      nvectors     = _braid_CommHandleElt(handle, nvectors);
 
-      MPI_Waitall(num_requests, requests, status);
-      
-      if (request_type == 1) /* recv type */
+      if ( (nvectors > 0) && (_braid_CommHandleElt(handle, npacked) < nvectors) &&
+           (request_type == 0) )
       {
-         _braid_BufferStatusInit( 0, 0, bstatus );
-         braid_BaseVector  *vector_ptr = _braid_CommHandleElt(handle, vector_ptr);
-         
-         /* Store the sender rank the bufferStatus */   
-         _braid_StatusElt(bstatus, send_recv_rank ) = status->MPI_SOURCE;
-         
-         _braid_BaseBufUnpack(core, app,  buffer, vector_ptr, bstatus);
+         _braid_Error(braid_ERROR_GENERIC, "Aggregated send waited on before all vectors were packed");
       }
-      
-      _braid_TFree(requests);
-      _braid_TFree(status);
-      _braid_TFree(handle);
-      _braid_TFree(buffer);
+
+      if (request_type == 1)
+      {
+         /* Measure how long this processor sits idle waiting on its neighbor */
+         braid_Real  wait_time = MPI_Wtime();
+
+         if (_braid_CommHandleElt(handle, shm_slot) != NULL)
+         {
+            _braid_ShmRecv(core, _braid_CommHandleElt(handle, shm_slot),
+                           _braid_CommHandleElt(handle, vector_ptr));
+         }
+         else
+         {
+            MPI_Waitall(num_requests, requests, status);
+         }
+         _braid_CoreElt(core, recv_wait)[level] += MPI_Wtime() - wait_time;
+      }
+      else
+      {
+         MPI_Waitall(num_requests, requests, status);
+      }
+
+      _braid_CommFinish(core, handle);
 
       *handle_ptr = NULL;
    }
@@ -167,3 +827,51 @@ _braid_CommWait(braid_Core          core,
    return _braid_error_flag;
 }
 
+/*----------------------------------------------------------------------------
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_CommTest(braid_Core          core,
+                _braid_CommHandle **handle_ptr)
+{
+   _braid_CommHandle  *handle = *handle_ptr;
+   int                 flag;
+
+   if (handle != NULL)
+   {
+      braid_Int      num_requests = _braid_CommHandleElt(handle, num_requests);
+      MPI_Request   *requests     = _braid_CommHandleElt(handle, requests) +
+                                    _braid_CommHandleElt(handle, phase);
+      MPI_Status    *status       = _braid_CommHandleElt(handle, status);
+      braid_Int      nvectors     = _braid_CommHandleElt(handle, nvectors);
+
+      /* An aggregated send is not posted until all vectors are packed */
+      if ( (nvectors > 0) && (_braid_CommHandleElt(handle, npacked) < nvectors) &&
+           (_braid_CommHandleElt(handle, request_type) == 0) )
+      {
+         return _braid_error_flag;
+      }
+
+      if (_braid_CommHandleElt(handle, shm_slot) != NULL)
+      {
+         _braid_ShmTest(core, _braid_CommHandleElt(handle, shm_slot), &flag);
+         if (flag)
+         {
+            _braid_ShmRecv(core, _braid_CommHandleElt(handle, shm_slot),
+                           _braid_CommHandleElt(handle, vector_ptr));
+         }
+      }
+      else
+      {
+         MPI_Testall(num_requests, requests, &flag, status);
+      }
+      if (flag)
+      {
+         _braid_CommFinish(core, handle);
+         *handle_ptr = NULL;
+      }
+   }
+
+   return _braid_error_flag;
+}
+
@@ -0,0 +1,671 @@
+/*BHEADER**********************************************************************
+ * Copyright (c) 2013, Lawrence Livermore National Security, LLC.
+ * Produced at the Lawrence Livermore National Laboratory.
+ *
+ * This file is part of XBraid. For support, post issues to the XBraid Github page.
+ *
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License (as published by the Free Software
+ * Foundation) version 2.1 dated February 1999.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the IMPLIED WARRANTY OF MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE. See the terms and conditions of the GNU General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc., 59
+ * Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+ ***********************************************************************EHEADER*/
+
+/** \file compress.c
+ * \brief Source code for compressing and decompressing vector messages.  See
+ * braid_SetCompression() for more information.
+ *
+ * Both codecs view the packed buffer as an array of braid_Reals (any trailing
+ * bytes are copied as is).  Each value is turned into a 64-bit word that is
+ * usually small: the XOR with the previous value (lossless) or the zigzag
+ * encoded difference of quantized values (lossy).  Only the significant bytes
+ * of each word are stored, with their count in a 4-bit code.  Any trailing
+ * bytes are stored first.
+ *
+ * The lossy codec rounds every 8 bytes as a braid_Real, so it is only used if
+ * the application declares with braid_SetPackedReals that the buffer holds
+ * nothing else (any C integer would be corrupted).  The quantization step is a
+ * power of two no larger than one, so integer values stored as reals are
+ * reconstructed exactly.
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <float.h>
+#include "_braid.h"
+#include "util.h"
+
+/* Compressed messages start with this header */
+typedef struct
+{
+   braid_Int   method;     /* method used, braid_COMPRESS_NONE if the data was copied */
+   braid_Int   raw_size;   /* size in bytes of the packed data */
+   braid_Real  step;       /* quantization step for lossy compression */
+} _braid_CompressHeader;
+
+/* Vectors stored in reduced precision start with this header */
+typedef struct
+{
+   braid_Int   raw_size;   /* size in bytes of the packed data */
+   braid_Int   reduced;    /* 1 if the reals are stored as floats, 0 if copied */
+} _braid_ReducedHeader;
+
+/* Vectors in delta storage (and their references) start with this header */
+typedef struct
+{
+   braid_Int   raw_size;   /* size in bytes of the packed data */
+   braid_Int   size;       /* size in bytes of the stored data */
+   braid_Int   encoded;    /* 1 if encoded relative to the reference, 0 if copied */
+} _braid_DeltaHeader;
+
+/*----------------------------------------------------------------------------
+ * Store the significant bytes of the n words w (with 4-bit byte counts up
+ * front).  Returns the number of bytes written, or -1 if out would overflow.
+ *----------------------------------------------------------------------------*/
+
+static braid_Int
+_braid_EncodeWords(uint64_t        *w,
+                   braid_Int        n,
+                   unsigned char   *out,
+                   braid_Int        max_out)
+{
+   unsigned char  *ctrl = out;
+   braid_Int       pos  = (n+1)/2;
+   braid_Int       i, nb;
+   uint64_t        x;
+
+   if (pos > max_out)
+   {
+      return -1;
+   }
+   memset(ctrl, 0, pos);
+   for (i = 0; i < n; i++)
+   {
+      x  = w[i];
+      nb = 0;
+      while (x != 0)
+      {
+         if (pos >= max_out)
+         {
+            return -1;
+         }
+         out[pos++] = (unsigned char) (x & 0xff);
+         x >>= 8;
+         nb++;
+      }
+      ctrl[i/2] |= (unsigned char) (nb << (4*(i%2)));
+   }
+
+   return pos;
+}
+
+/*----------------------------------------------------------------------------
+ *----------------------------------------------------------------------------*/
+
+static braid_Int
+_braid_DecodeWords(unsigned char   *in,
+                   braid_Int        n,
+                   uint64_t        *w)
+{
+   unsigned char  *ctrl = in;
+   braid_Int       pos  = (n+1)/2;
+   braid_Int       i, b, nb;
+   uint64_t        x;
+
+   for (i = 0; i < n; i++)
+   {
+      nb = (ctrl[i/2] >> (4*(i%2))) & 0xf;
+      x  = 0;
+      for (b = 0; b < nb; b++)
+      {
+         x |= ((uint64_t) in[pos++]) << (8*b);
+      }
+      w[i] = x;
+   }
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_CompressBound(braid_Int   raw_size,
+                     braid_Int  *bound_ptr)
+{
+   /* Data that does not compress is copied, so this is a strict bound */
+   *bound_ptr = sizeof(_braid_CompressHeader) + raw_size;
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ * Returns the core scratch buffer, grown to at least 'size' bytes
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_CompressScratch(braid_Core   core,
+                       braid_Int    size,
+                       void       **buffer_ptr)
+{
+   if (size > _braid_CoreElt(core, comp_buffer_size))
+   {
+      free(_braid_CoreElt(core, comp_buffer));
+      _braid_CoreElt(core, comp_buffer)      = malloc(size);
+      _braid_CoreElt(core, comp_buffer_size) = size;
+   }
+   *buffer_ptr = _braid_CoreElt(core, comp_buffer);
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ * Returns the core scratch buffer for stored vectors, grown to at least 'size'
+ * bytes
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_StorageScratch(braid_Core   core,
+                      braid_Int    size,
+                      void       **buffer_ptr)
+{
+   if (size > _braid_CoreElt(core, store_buffer_size))
+   {
+      free(_braid_CoreElt(core, store_buffer));
+      _braid_CoreElt(core, store_buffer)      = malloc(size);
+      _braid_CoreElt(core, store_buffer_size) = size;
+   }
+   *buffer_ptr = _braid_CoreElt(core, store_buffer);
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_Compress(braid_Core   core,
+                void        *raw,
+                braid_Int    raw_size,
+                void        *comp,
+                braid_Int   *comp_size_ptr)
+{
+   braid_Int              method   = _braid_CoreElt(core, compress);
+   braid_Real             comp_tol = _braid_CoreElt(core, compress_tol);
+   braid_Real            *stats    = _braid_CoreElt(core, comp_stats);
+   _braid_CompressHeader *header   = (_braid_CompressHeader *) comp;
+   unsigned char         *data     = (unsigned char *) comp + sizeof(_braid_CompressHeader);
+   braid_Int              n        = raw_size / sizeof(braid_Real);
+   braid_Int              ntail    = raw_size - n*sizeof(braid_Real);
+   braid_Int              size     = -1;
+   braid_Real             rnorm, step, v, localtime;
+   int                    e;
+   uint64_t              *w;
+   uint64_t               bits, prev;
+   int64_t                q, qprev, d;
+   braid_Int              i;
+
+   localtime = MPI_Wtime();
+
+   /* Work array for the transformed words */
+   w = (uint64_t *) _braid_CoreElt(core, comp_words);
+   if (n > _braid_CoreElt(core, comp_nwords))
+   {
+      _braid_TFree(w);
+      w = _braid_TAlloc(uint64_t, n);
+      _braid_CoreElt(core, comp_words)  = w;
+      _braid_CoreElt(core, comp_nwords) = n;
+   }
+
+   /* The lossy tolerance follows the residual, so early iterations tolerate
+    * more error.  Each value is off by at most step/2 = comp_tol*rnorm. */
+   step = 0.0;
+   if ( (method == braid_COMPRESS_LOSSY) && _braid_CoreElt(core, packed_reals) )
+   {
+      _braid_GetRNorm(core, -1, &rnorm);
+      if (rnorm > 0.0)
+      {
+         /* Largest power of two <= 2*comp_tol*rnorm, capped at one */
+         step = 2.0*comp_tol*rnorm;
+         if (step > 0.0)
+         {
+            frexp(step, &e);
+            step = (e > 1) ? 1.0 : ldexp(1.0, e-1);
+         }
+      }
+   }
+   if (step > 0.0)
+   {
+      qprev = 0;
+      for (i = 0; i < n; i++)
+      {
+         memcpy(&v, (char *) raw + i*sizeof(braid_Real), sizeof(braid_Real));
+         /* Values that do not fit the quantization fall back to lossless */
+         if ( !(fabs(v/step) < 4.0e15) )
+         {
+            step = 0.0;
+            break;
+         }
+         q     = (int64_t) floor(v/step + 0.5);
+         d     = q - qprev;
+         w[i]  = ((uint64_t) d << 1) ^ (uint64_t) (d >> 63);   /* zigzag */
+         qprev = q;
+      }
+   }
+   if (step > 0.0)
+   {
+      header->method = braid_COMPRESS_LOSSY;
+   }
+   else
+   {
+      prev = 0;
+      for (i = 0; i < n; i++)
+      {
+         memcpy(&bits, (char *) raw + i*sizeof(braid_Real), sizeof(braid_Real));
+         w[i] = bits ^ prev;
+         prev = bits;
+      }
+      header->method = braid_COMPRESS_LOSSLESS;
+   }
+
+   if (method != braid_COMPRESS_NONE)
+   {
+      size = _braid_EncodeWords(w, n, data + ntail, raw_size - ntail);
+   }
+   if (size < 0)
+   {
+      /* Did not compress, copy instead */
+      header->method = braid_COMPRESS_NONE;
+      memcpy(data, raw, raw_size);
+      size = raw_size;
+   }
+   else
+   {
+      memcpy(data, (char *) raw + n*sizeof(braid_Real), ntail);
+      size += ntail;
+   }
+   header->raw_size = raw_size;
+   header->step     = step;
+
+   *comp_size_ptr = sizeof(_braid_CompressHeader) + size;
+
+   stats[0] += raw_size;
+   stats[1] += *comp_size_ptr;
+   stats[2] += MPI_Wtime() - localtime;
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_Decompress(braid_Core   core,
+                  void        *comp,
+                  void       **raw_ptr,
+                  braid_Int   *raw_size_ptr)
+{
+   braid_Real            *stats    = _braid_CoreElt(core, comp_stats);
+   _braid_CompressHeader *header   = (_braid_CompressHeader *) comp;
+   unsigned char         *data     = (unsigned char *) comp + sizeof(_braid_CompressHeader);
+   braid_Int              raw_size = header->raw_size;
+   braid_Int              n        = raw_size / sizeof(braid_Real);
+   braid_Int              ntail    = raw_size - n*sizeof(braid_Real);
+   braid_Real             step     = header->step;
+   void                  *raw;
+   braid_Real             v, localtime;
+   uint64_t              *w;
+   uint64_t               bits;
+   int64_t                q, d;
+   braid_Int              i;
+
+   localtime = MPI_Wtime();
+
+   _braid_CompressScratch(core, raw_size, &raw);
+   if (header->method == braid_COMPRESS_NONE)
+   {
+      memcpy(raw, data, raw_size);
+   }
+   else
+   {
+      w = (uint64_t *) _braid_CoreElt(core, comp_words);
+      if (n > _braid_CoreElt(core, comp_nwords))
+      {
+         _braid_TFree(w);
+         w = _braid_TAlloc(uint64_t, n);
+         _braid_CoreElt(core, comp_words)  = w;
+         _braid_CoreElt(core, comp_nwords) = n;
+      }
+      memcpy((char *) raw + n*sizeof(braid_Real), data, ntail);
+      _braid_DecodeWords(data + ntail, n, w);
+
+      if (header->method == braid_COMPRESS_LOSSY)
+      {
+         q = 0;
+         for (i = 0; i < n; i++)
+         {
+            d = (int64_t) (w[i] >> 1) ^ -((int64_t) (w[i] & 1));
+            q += d;
+            v  = ((braid_Real) q)*step;
+            memcpy((char *) raw + i*sizeof(braid_Real), &v, sizeof(braid_Real));
+         }
+      }
+      else
+      {
+         bits = 0;
+         for (i = 0; i < n; i++)
+         {
+            bits ^= w[i];
+            memcpy((char *) raw + i*sizeof(braid_Real), &bits, sizeof(braid_Real));
+         }
+      }
+   }
+   *raw_ptr      = raw;
+   *raw_size_ptr = raw_size;
+
+   stats[2] += MPI_Wtime() - localtime;
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_ReducedBound(braid_Int   raw_size,
+                    braid_Int  *bound_ptr)
+{
+   *bound_ptr = sizeof(_braid_ReducedHeader) + raw_size;
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ * Reduced precision storage views the packed buffer as an array of
+ * braid_Reals, like the codecs above, and stores each as a float.  This needs
+ * a buffer of only reals (see braid_SetPackedReals), since an integer would be
+ * rounded.  If the buffer may hold other data, any value is out of the float
+ * range, or 'reduce' is false, the data is copied instead.
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_ReducePrecision(braid_Core   core,
+                       void        *raw,
+                       braid_Int    raw_size,
+                       braid_Int    reduce,
+                       void       **packed_ptr,
+                       braid_Int   *packed_size_ptr)
+{
+   braid_Int              n       = raw_size / sizeof(braid_Real);
+   braid_Int              ntail   = raw_size - n*sizeof(braid_Real);
+   braid_Int              reduced = reduce && _braid_CoreElt(core, packed_reals);
+   braid_Int              size;
+   _braid_ReducedHeader  *header;
+   unsigned char         *data;
+   braid_Real             v;
+   float                  f;
+   braid_Int              i;
+
+   for (i = 0; (i < n) && reduced; i++)
+   {
+      memcpy(&v, (char *) raw + i*sizeof(braid_Real), sizeof(braid_Real));
+      if ( !(fabs(v) <= FLT_MAX) || ((v != 0.0) && (fabs(v) < FLT_MIN)) )
+      {
+         reduced = 0;
+         break;
+      }
+   }
+
+   if (reduced)
+   {
+      size   = sizeof(_braid_ReducedHeader) + n*sizeof(float) + ntail;
+      header = (_braid_ReducedHeader *) malloc(size);
+      data   = (unsigned char *) header + sizeof(_braid_ReducedHeader);
+      for (i = 0; i < n; i++)
+      {
+         memcpy(&v, (char *) raw + i*sizeof(braid_Real), sizeof(braid_Real));
+         f = (float) v;
+         memcpy(data + i*sizeof(float), &f, sizeof(float));
+      }
+      memcpy(data + n*sizeof(float), (char *) raw + n*sizeof(braid_Real), ntail);
+   }
+   else
+   {
+      size   = sizeof(_braid_ReducedHeader) + raw_size;
+      header = (_braid_ReducedHeader *) malloc(size);
+      data   = (unsigned char *) header + sizeof(_braid_ReducedHeader);
+      memcpy(data, raw, raw_size);
+   }
+   header->raw_size = raw_size;
+   header->reduced  = reduced;
+
+   *packed_ptr      = (void *) header;
+   *packed_size_ptr = size;
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_ExpandPrecision(braid_Core   core,
+                       void        *packed,
+                       void       **raw_ptr,
+                       braid_Int   *raw_size_ptr)
+{
+   _braid_ReducedHeader  *header   = (_braid_ReducedHeader *) packed;
+   unsigned char         *data     = (unsigned char *) packed + sizeof(_braid_ReducedHeader);
+   braid_Int              raw_size = header->raw_size;
+   braid_Int              n        = raw_size / sizeof(braid_Real);
+   braid_Int              ntail    = raw_size - n*sizeof(braid_Real);
+   void                  *raw;
+   braid_Real             v;
+   float                  f;
+   braid_Int              i;
+
+   _braid_StorageScratch(core, raw_size, &raw);
+   if (header->reduced)
+   {
+      for (i = 0; i < n; i++)
+      {
+         memcpy(&f, data + i*sizeof(float), sizeof(float));
+         v = (braid_Real) f;
+         memcpy((char *) raw + i*sizeof(braid_Real), &v, sizeof(braid_Real));
+      }
+      memcpy((char *) raw + n*sizeof(braid_Real), data + n*sizeof(float), ntail);
+   }
+   else
+   {
+      memcpy(raw, data, raw_size);
+   }
+
+   *raw_ptr      = raw;
+   *raw_size_ptr = raw_size;
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ * The default delta codec views the packed buffer as an array of braid_Reals,
+ * like the codecs above, but XORs each value with the reference value at the
+ * same position instead of the previous one.  Nearly equal values then differ
+ * only in their low mantissa bytes.
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_DeltaEncode(braid_Core   core,
+                   void        *ref,
+                   void        *raw,
+                   braid_Int    raw_size,
+                   void       **packed_ptr,
+                   braid_Int   *packed_size_ptr)
+{
+   braid_App            app     = _braid_CoreElt(core, app);
+   braid_Int            n       = raw_size / sizeof(braid_Real);
+   braid_Int            ntail   = raw_size - n*sizeof(braid_Real);
+   braid_Int            size    = -1;
+   _braid_DeltaHeader  *header;
+   unsigned char       *data, *ref_data;
+   braid_Int            ref_size;
+   uint64_t            *w;
+   uint64_t             bits, ref_bits;
+   braid_Int            i;
+
+   header = (_braid_DeltaHeader *) malloc(sizeof(_braid_DeltaHeader) + raw_size);
+   data   = (unsigned char *) header + sizeof(_braid_DeltaHeader);
+
+   if (ref != NULL)
+   {
+      _braid_DeltaData(ref, (void **) &ref_data, &ref_size);
+      if (_braid_CoreElt(core, delta_encode) != NULL)
+      {
+         _braid_CoreFcn(core, delta_encode)(app, ref_data, ref_size, raw, raw_size, data, &size);
+      }
+      else if (ref_size == raw_size)
+      {
+         w = (uint64_t *) _braid_CoreElt(core, comp_words);
+         if (n > _braid_CoreElt(core, comp_nwords))
+         {
+            _braid_TFree(w);
+            w = _braid_TAlloc(uint64_t, n);
+            _braid_CoreElt(core, comp_words)  = w;
+            _braid_CoreElt(core, comp_nwords) = n;
+         }
+         for (i = 0; i < n; i++)
+         {
+            memcpy(&bits, (char *) raw + i*sizeof(braid_Real), sizeof(braid_Real));
+            memcpy(&ref_bits, ref_data + i*sizeof(braid_Real), sizeof(braid_Real));
+            w[i] = bits ^ ref_bits;
+         }
+         size = _braid_EncodeWords(w, n, data + ntail, raw_size - ntail);
+         if (size > -1)
+         {
+            memcpy(data, (char *) raw + n*sizeof(braid_Real), ntail);
+            size += ntail;
+         }
+      }
+   }
+
+   if ( (size < 0) || (size > raw_size) )
+   {
+      /* No reference, or the difference did not fit, copy instead */
+      memcpy(data, raw, raw_size);
+      size = raw_size;
+      header->encoded = 0;
+   }
+   else
+   {
+      header = (_braid_DeltaHeader *) realloc(header, sizeof(_braid_DeltaHeader) + size);
+      header->encoded = 1;
+   }
+   header->raw_size = raw_size;
+   header->size     = size;
+
+   *packed_ptr      = (void *) header;
+   *packed_size_ptr = sizeof(_braid_DeltaHeader) + size;
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_DeltaDecode(braid_Core   core,
+                   void        *ref,
+                   void        *packed,
+                   void       **raw_ptr,
+                   braid_Int   *raw_size_ptr)
+{
+   braid_App            app      = _braid_CoreElt(core, app);
+   _braid_DeltaHeader  *header   = (_braid_DeltaHeader *) packed;
+   unsigned char       *data     = (unsigned char *) packed + sizeof(_braid_DeltaHeader);
+   braid_Int            raw_size = header->raw_size;
+   braid_Int            n        = raw_size / sizeof(braid_Real);
+   braid_Int            ntail    = raw_size - n*sizeof(braid_Real);
+   void                *raw;
+   unsigned char       *ref_data;
+   braid_Int            ref_size;
+   uint64_t            *w;
+   uint64_t             bits, ref_bits;
+   braid_Int            i;
+
+   _braid_StorageScratch(core, raw_size, &raw);
+   if (!header->encoded)
+   {
+      memcpy(raw, data, raw_size);
+   }
+   else
+   {
+      _braid_DeltaData(ref, (void **) &ref_data, &ref_size);
+      if (_braid_CoreElt(core, delta_decode) != NULL)
+      {
+         _braid_CoreFcn(core, delta_decode)(app, ref_data, ref_size, data, header->size, raw, raw_size);
+      }
+      else
+      {
+         w = (uint64_t *) _braid_CoreElt(core, comp_words);
+         if (n > _braid_CoreElt(core, comp_nwords))
+         {
+            _braid_TFree(w);
+            w = _braid_TAlloc(uint64_t, n);
+            _braid_CoreElt(core, comp_words)  = w;
+            _braid_CoreElt(core, comp_nwords) = n;
+         }
+         memcpy((char *) raw + n*sizeof(braid_Real), data, ntail);
+         _braid_DecodeWords(data + ntail, n, w);
+         for (i = 0; i < n; i++)
+         {
+            memcpy(&ref_bits, ref_data + i*sizeof(braid_Real), sizeof(braid_Real));
+            bits = w[i] ^ ref_bits;
+            memcpy((char *) raw + i*sizeof(braid_Real), &bits, sizeof(braid_Real));
+         }
+      }
+   }
+
+   *raw_ptr      = raw;
+   *raw_size_ptr = raw_size;
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_DeltaSizes(void        *packed,
+                  braid_Int   *raw_size_ptr,
+                  braid_Int   *size_ptr)
+{
+   _braid_DeltaHeader  *header = (_braid_DeltaHeader *) packed;
+
+   *raw_size_ptr = header->raw_size;
+   *size_ptr     = sizeof(_braid_DeltaHeader) + header->size;
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_DeltaData(void        *ref,
+                 void       **raw_ptr,
+                 braid_Int   *raw_size_ptr)
+{
+   _braid_DeltaHeader  *header = (_braid_DeltaHeader *) ref;
+
+   *raw_ptr      = (unsigned char *) ref + sizeof(_braid_DeltaHeader);
+   *raw_size_ptr = header->raw_size;
+
+   return _braid_error_flag;
+}
@@ -105,13 +105,12 @@ _braid_GetDistribution(braid_Core   core,
                        braid_Int   *ilower_ptr,
                        braid_Int   *iupper_ptr)
 {
-   MPI_Comm   comm    = _braid_CoreElt(core, comm);
    braid_Int  gupper = _braid_CoreElt(core, gupper);
-   braid_Int  npoints, nprocs, proc;
+   braid_Int  nprocs = _braid_CoreElt(core, nprocs);
+   braid_Int  proc   = _braid_CoreElt(core, myid);
+   braid_Int  npoints;
 
    npoints = gupper + 1;
-   MPI_Comm_size(comm, &nprocs);
-   MPI_Comm_rank(comm, &proc);
 
    _braid_GetBlockDistInterval(npoints, nprocs, proc, ilower_ptr, iupper_ptr);
 
@@ -129,19 +128,38 @@ _braid_GetProc(braid_Core   core,
                braid_Int    index,
                braid_Int   *proc_ptr)
 {
-   MPI_Comm       comm   = _braid_CoreElt(core, comm);
    _braid_Grid  **grids  = _braid_CoreElt(core, grids);
+   _braid_Grid   *grid   = grids[level];
    braid_Int      gupper = _braid_CoreElt(core, gupper);
-   braid_Int      npoints, nprocs;
+   braid_Int      nprocs = _braid_CoreElt(core, nprocs);
+   braid_Int      fscale = _braid_GridElt(grid, fscale);
+   braid_Int      npoints;
    braid_Int      l, cfactor;
 
    npoints = gupper + 1;
-   MPI_Comm_size(comm, &nprocs);
-   /* Map index to the finest grid */
-   for (l = level-1; l > -1; l--)
+   if (fscale > 0)
    {
-      cfactor = _braid_GridElt(grids[l], cfactor);
-      _braid_MapCoarseToFine(index, cfactor, index);
+      /* Use the cached neighbor ranks, or the cached map to the finest grid */
+      if (index == _braid_GridElt(grid, ilower)-1)
+      {
+         *proc_ptr = _braid_GridElt(grid, left_proc);
+         return _braid_error_flag;
+      }
+      if (index == _braid_GridElt(grid, iupper)+1)
+      {
+         *proc_ptr = _braid_GridElt(grid, right_proc);
+         return _braid_error_flag;
+      }
+      index *= fscale;
+   }
+   else
+   {
+      /* Map index to the finest grid */
+      for (l = level-1; l > -1; l--)
+      {
+         cfactor = _braid_GridElt(grids[l], cfactor);
+         _braid_MapCoarseToFine(index, cfactor, index);
+      }
    }
 
    _braid_GetBlockDistProc(npoints, nprocs, index, _braid_CoreElt(core, periodic), proc_ptr);
@@ -149,3 +167,37 @@ _braid_GetProc(braid_Core   core,
    return _braid_error_flag;
 }
 
+
+/*----------------------------------------------------------------------------
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_InitProcCache(braid_Core  core)
+{
+   _braid_Grid  **grids    = _braid_CoreElt(core, grids);
+   braid_Int      nlevels  = _braid_CoreElt(core, nlevels);
+   braid_Int      npoints  = _braid_CoreElt(core, gupper) + 1;
+   braid_Int      nprocs   = _braid_CoreElt(core, nprocs);
+   braid_Int      periodic = _braid_CoreElt(core, periodic);
+   braid_Int      level, fscale, ilower, iupper;
+
+   fscale = 1;
+   for (level = 0; level < nlevels; level++)
+   {
+      ilower = _braid_GridElt(grids[level], ilower);
+      iupper = _braid_GridElt(grids[level], iupper);
+
+      _braid_GetBlockDistProc(npoints, nprocs, (ilower-1)*fscale, periodic,
+                              &_braid_GridElt(grids[level], left_proc));
+      _braid_GetBlockDistProc(npoints, nprocs, (iupper+1)*fscale, periodic,
+                              &_braid_GridElt(grids[level], right_proc));
+      _braid_GridElt(grids[level], fscale) = fscale;
+
+      if (level < nlevels-1)
+      {
+         fscale *= _braid_GridElt(grids[level], cfactor);
+      }
+   }
+
+   return _braid_error_flag;
+}
@@ -32,6 +32,8 @@ typedef struct
    braid_Int  try_refine;
    braid_Int  fmglevel;
    braid_Int  fmg_Vcyc;
+   braid_Int *ncycled;     /* coarse-grid corrections done on each level */
+   braid_Int  ncycled_size;
    FILE      *outfile;
 
 } _braid_CycleState;
@@ -53,10 +55,15 @@ _braid_DriveInitCycle(braid_Core          core,
 
    _braid_CycleState  cycle;
 
-   cycle.down       = 1;
-   cycle.try_refine = 0;
-   cycle.fmglevel   = 0;
-   cycle.fmg_Vcyc   = 0;
+   /* F-cycles are FMG cycles on every iteration (unless nfmg is set) */
+   fmg = fmg || (_braid_CoreElt(core, cycle) == braid_CYCLE_F);
+
+   cycle.down         = 1;
+   cycle.try_refine   = 0;
+   cycle.fmglevel     = 0;
+   cycle.fmg_Vcyc     = 0;
+   cycle.ncycled_size = nlevels;
+   cycle.ncycled      = _braid_CTAlloc(braid_Int, nlevels);
 
    if (fmg && (nfmg != 0))
    {
@@ -98,13 +105,29 @@ _braid_DriveUpdateCycle(braid_Core          core,
    braid_Int      fmg       = _braid_CoreElt(core, fmg);
    braid_Int      nfmg      = _braid_CoreElt(core, nfmg);
    braid_Int      nfmg_Vcyc = _braid_CoreElt(core, nfmg_Vcyc);
+   braid_Int     *ncycles   = _braid_CoreElt(core, ncycles);
+   braid_Real    *nvisits   = _braid_CoreElt(core, nvisits);
    braid_Int      nlevels   = _braid_CoreElt(core, nlevels);
    braid_Int      io_level  = _braid_CoreElt(core, io_level);
    _braid_CycleState  cycle = *cycle_ptr;
    braid_Real     rnorm;
+   braid_Int      i;
 
    _braid_GetRNorm(core, -1, &rnorm);
 
+   fmg = fmg || (_braid_CoreElt(core, cycle) == braid_CYCLE_F);
+
+   /* Refinement may have added levels */
+   if (nlevels > cycle.ncycled_size)
+   {
+      cycle.ncycled = _braid_TReAlloc(cycle.ncycled, braid_Int, nlevels);
+      for (i = cycle.ncycled_size; i < nlevels; i++)
+      {
+         cycle.ncycled[i] = 0;
+      }
+      cycle.ncycled_size = nlevels;
+   }
+
    if (cycle.down)
    {
       /* Down cycle */
@@ -135,6 +158,20 @@ _braid_DriveUpdateCycle(braid_Core          core,
 
             cycle.down = 1;
          }
+         else if (level < (nlevels-1))
+         {
+            /* Otherwise, do ncycles coarse-grid corrections on this level
+             * before going up (1 for V-cycles, 2 for W-cycles) */
+            cycle.ncycled[level]++;
+            if (cycle.ncycled[level] < ncycles[level])
+            {
+               cycle.down = 1;
+            }
+            else
+            {
+               cycle.ncycled[level] = 0;
+            }
+         }
       }
       else
       {
@@ -157,6 +194,12 @@ _braid_DriveUpdateCycle(braid_Core          core,
       }
    }
 
+   /* Count the relaxations (or coarsest grid solves) on this level */
+   if ( cycle.down || ((level == (nlevels-1)) && (level > 0)) )
+   {
+      nvisits[level] += 1.0;
+   }
+
    /* Print to cycle output file */
    if (myid == 0 && io_level>=1)
    {
@@ -207,6 +250,7 @@ _braid_DriveEndCycle(braid_Core          core,
    {
       fclose(cycle.outfile);
    }
+   _braid_TFree(cycle.ncycled);
 
    *cycle_ptr = cycle;
 
@@ -438,7 +482,8 @@ _braid_Drive(braid_Core  core,
    braid_Int            obj_only        = _braid_CoreElt(core, obj_only);
    braid_Int            adjoint         = _braid_CoreElt(core, adjoint);
    braid_Int            seq_soln        = _braid_CoreElt(core, seq_soln);
-   braid_SyncStatus     sstatus         = (braid_SyncStatus)core;
+   _braid_SyncStatus    sstatus_s;
+   braid_SyncStatus     sstatus         = &sstatus_s;
 
    braid_Int     *nrels;
    braid_Int      nlevels;
@@ -449,6 +494,8 @@ _braid_Drive(braid_Core  core,
    _braid_CycleState  cycle;
    braid_Int          iter, level, done, refined;
 
+   _braid_StatusInit(core, (braid_Status) sstatus);
+
    /* Initialize cycle state */
    _braid_DriveInitCycle(core, &cycle);
 
@@ -55,6 +55,176 @@ _braid_GridInit(braid_Core     core,
    return _braid_error_flag;
 }
 
+/*----------------------------------------------------------------------------
+ * Add up the buffer sizes of a list of comm handles
+ *----------------------------------------------------------------------------*/
+
+static braid_Int
+_braid_CommHandleBytes(_braid_CommHandle  *handle,
+                       braid_Real         *bytes_ptr)
+{
+   for ( ; handle != NULL; handle = _braid_CommHandleElt(handle, next))
+   {
+      *bytes_ptr += _braid_CommHandleElt(handle, buffer_size);
+   }
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ * Full vectors are sized with BufSize, so this counts the data the user packs
+ * for a vector.  Shells are counted, and charged the full-vector size they
+ * save.  Packed points (reduced precision, out of core) are not included.
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_GridMemory(braid_Core    core,
+                  _braid_Grid  *grid)
+{
+   braid_App           app      = _braid_CoreElt(core, app);
+   braid_Int           storage  = _braid_CoreElt(core, storage);
+   braid_Int           useshell = _braid_CoreElt(core, useshell);
+   _braid_BufferStatus bstatus_s;
+   braid_BufferStatus  bstatus  = &bstatus_s;
+   braid_Int           level    = _braid_GridElt(grid, level);
+   braid_Int           ilower   = _braid_GridElt(grid, ilower);
+   braid_Int           iupper   = _braid_GridElt(grid, iupper);
+   braid_Int           cfactor  = _braid_GridElt(grid, cfactor);
+   braid_Int           nupoints = _braid_GridElt(grid, nupoints);
+   braid_BaseVector   *ua       = _braid_GridElt(grid, ua);
+   braid_BaseVector   *va       = _braid_GridElt(grid, va);
+   braid_BaseVector   *fa       = _braid_GridElt(grid, fa);
+   braid_Real         *peak     = &(_braid_CoreElt(core, mem_peak)[level*_braid_NMemStats]);
+   braid_Real          stats[_braid_NMemStats];
+   _braid_CommHandle  *handle;
+   braid_Int           size, nfull, nshells, ii;
+
+   _braid_StatusInit(core, (braid_Status) bstatus);
+
+   nfull = nshells = 0;
+   if (_braid_GridElt(grid, ua_alloc))
+   {
+      for (ii = 0; ii < nupoints; ii++)
+      {
+         if (ua[ii] == NULL)
+         {
+            continue;
+         }
+         /* With shells, all points are stored and F-points only hold a shell */
+         if ( useshell && ((storage < 0) || (level < storage)) &&
+              !_braid_IsCPoint(ilower+ii, cfactor) )
+         {
+            nshells++;
+         }
+         else
+         {
+            nfull++;
+         }
+      }
+   }
+   for (ii = -1; ii <= (iupper-ilower); ii++)
+   {
+      if (_braid_GridElt(grid, va_alloc) && (va[ii] != NULL))
+      {
+         nfull++;
+      }
+      if (_braid_GridElt(grid, fa_alloc) && (fa[ii] != NULL))
+      {
+         nfull++;
+      }
+   }
+
+   _braid_BufferStatusInit(0, 0, bstatus);
+   _braid_BaseBufSize(core, app,  &size, bstatus);
+
+   if (_braid_GridElt(grid, scratch) != NULL)
+   {
+      nfull++;
+   }
+
+   stats[_braid_MemFull]       = (braid_Real) nfull * size;
+   stats[_braid_MemShells]     = (braid_Real) nshells;
+   stats[_braid_MemShellSaved] = (braid_Real) nshells * size;
+   stats[_braid_MemComm]       = 0.0;
+   _braid_CommHandleBytes(_braid_GridElt(grid, comm_pool), &stats[_braid_MemComm]);
+   _braid_CommHandleBytes(_braid_GridElt(grid, recv_persist), &stats[_braid_MemComm]);
+   _braid_CommHandleBytes(_braid_GridElt(grid, send_persist), &stats[_braid_MemComm]);
+   if (_braid_GridElt(grid, shm_recv) != NULL)
+   {
+      /* This processor's shared-memory message slots for the level */
+      stats[_braid_MemComm] += _braid_NPhases*_braid_ShmNBuffers*_braid_CoreElt(core, shm_slot_size);
+   }
+   for (ii = 0; ii < 2; ii++)
+   {
+      /* Messages in flight (persistent ones are counted above) */
+      handle = (ii == 0) ? _braid_GridElt(grid, recv_handle) : _braid_GridElt(grid, send_handle);
+      if ( (handle != NULL) && !_braid_CommHandleElt(handle, persistent) )
+      {
+         stats[_braid_MemComm] += _braid_CommHandleElt(handle, buffer_size);
+      }
+   }
+
+   for (ii = 0; ii < _braid_NMemStats; ii++)
+   {
+      peak[ii] = _braid_max(peak[ii], stats[ii]);
+   }
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_GridScratch(braid_Core         core,
+                   _braid_Grid       *grid,
+                   braid_BaseVector   u,
+                   braid_BaseVector  *r_ptr)
+{
+   braid_App         app     = _braid_CoreElt(core, app);
+   braid_BaseVector  scratch = _braid_GridElt(grid, scratch);
+
+   if ( !_braid_BasePoolOn(core) )
+   {
+      _braid_BaseClone(core, app,  u, r_ptr);
+   }
+   else if ( (scratch == NULL) ||
+             (_braid_BasePoolKey(core, u) != _braid_BasePoolKey(core, scratch)) )
+   {
+      /* Spatial refinement may change the size of vectors on a level */
+      if (scratch != NULL)
+      {
+         _braid_BaseFree(core, app,  scratch);
+      }
+      _braid_BaseClone(core, app,  u, &scratch);
+      _braid_GridElt(grid, scratch) = scratch;
+      *r_ptr = scratch;
+   }
+   else
+   {
+      _braid_BaseCopy(core, app, u, scratch);
+      *r_ptr = scratch;
+   }
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_GridScratchFree(braid_Core         core,
+                       _braid_Grid       *grid,
+                       braid_BaseVector   r)
+{
+   if (r != _braid_GridElt(grid, scratch))
+   {
+      _braid_BaseFree(core, _braid_CoreElt(core, app),  r);
+   }
+
+   return _braid_error_flag;
+}
+
 /*----------------------------------------------------------------------------
  *----------------------------------------------------------------------------*/
 
@@ -67,6 +237,7 @@ _braid_GridClean(braid_Core    core,
    braid_Int      iupper       = _braid_GridElt(grid, iupper);
    braid_Int      nupoints     = _braid_GridElt(grid, nupoints);
    braid_BaseVector  *ua       = _braid_GridElt(grid, ua);
+   void             **upack    = _braid_GridElt(grid, upack);
    braid_BaseVector  *va       = _braid_GridElt(grid, va);
    braid_BaseVector  *fa       = _braid_GridElt(grid, fa);
    braid_BaseVector  *ua_alloc = _braid_GridElt(grid, ua_alloc);
@@ -86,6 +257,27 @@ _braid_GridClean(braid_Core    core,
          }
       }
    }
+   if (upack)
+   {
+      for (ii = 0; ii < nupoints; ii++)
+      {
+         _braid_TFree(upack[ii]);
+      }
+   }
+   if (_braid_GridElt(grid, uspill))
+   {
+      for (ii = 0; ii < nupoints; ii++)
+      {
+         _braid_GridElt(grid, uspill)[ii] = 0;
+      }
+   }
+   if (_braid_GridElt(grid, uref))
+   {
+      for (ii = 0; ii <= nupoints/_braid_CoreElt(core, delta_keyframe); ii++)
+      {
+         _braid_TFree(_braid_GridElt(grid, uref)[ii]);
+      }
+   }
    if (va_alloc)
    {
       for (ii = -1; ii <= (iupper-ilower); ii++)
@@ -127,11 +319,28 @@ _braid_GridDestroy(braid_Core    core,
       braid_BaseVector  *fa_alloc = _braid_GridElt(grid, fa_alloc);
 
       _braid_GridClean(core, grid);
+      _braid_CommPoolDestroy(grid);
+      if (_braid_GridElt(grid, scratch))
+      {
+         _braid_BaseFree(core, _braid_CoreElt(core, app),  _braid_GridElt(grid, scratch));
+      }
 
       if (ua_alloc)
       {
          _braid_TFree(ua_alloc);
       }
+      if (_braid_GridElt(grid, upack))
+      {
+         _braid_TFree(_braid_GridElt(grid, upack));
+      }
+      if (_braid_GridElt(grid, uspill))
+      {
+         _braid_TFree(_braid_GridElt(grid, uspill));
+      }
+      if (_braid_GridElt(grid, uref))
+      {
+         _braid_TFree(_braid_GridElt(grid, uref));
+      }
       if (ta_alloc)
       {
          _braid_TFree(ta_alloc);
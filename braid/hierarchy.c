@@ -36,6 +36,8 @@ _braid_InitHierarchy(braid_Core    core,
    braid_Int      min_coarse = _braid_CoreElt(core, min_coarse);
    braid_Int     *nrels      = _braid_CoreElt(core, nrels);
    braid_Int      nrdefault  = _braid_CoreElt(core, nrdefault);
+   braid_Int     *ncycles    = _braid_CoreElt(core, ncycles);
+   braid_Int      ncdefault  = _braid_CoreElt(core, ncdefault);
    braid_Real    *CWts       = _braid_CoreElt(core, CWts);
    braid_Real     CWt_default= _braid_CoreElt(core, CWt_default);
    braid_Int      gupper     = _braid_CoreElt(core, gupper);
@@ -63,7 +65,7 @@ _braid_InitHierarchy(braid_Core    core,
 
    braid_Int         level;
    braid_Int         ilower, iupper;
-   braid_Int         clower, cupper, cfactor, ncpoints, nupoints;
+   braid_Int         clower, cupper, cfactor, ncpoints, nupoints, delta;
    braid_Real       *ta;
    braid_BaseVector *ua;
    braid_BaseVector *va;
@@ -102,13 +104,21 @@ _braid_InitHierarchy(braid_Core    core,
    rdtvalues = _braid_CTAlloc(braid_Real*, iupper-ilower+2); /* Ensures non-NULL */
    _braid_CoreElt(core, rdtvalues) = rdtvalues;
 
-   /* Set up nrels and Cwt array */
+   /* Set up nrels, ncycles and Cwt array */
+   if (ncdefault < 1)
+   {
+      ncdefault = (_braid_CoreElt(core, cycle) == braid_CYCLE_W) ? 2 : 1;
+   }
    for (level = 0; level < max_levels; level++)
    {
       if (nrels[level] < 0)
       {
          nrels[level] = nrdefault;
       }
+      if (ncycles[level] < 1)
+      {
+         ncycles[level] = ncdefault;
+      }
       if (CWts[level] < 0)
       {
          CWts[level] = CWt_default;
@@ -202,6 +212,9 @@ _braid_InitHierarchy(braid_Core    core,
    nlevels = level+1;
    _braid_CoreElt(core, nlevels) = nlevels;
 
+   /* Cache the neighbor ranks now that the hierarchy is known */
+   _braid_InitProcCache(core);
+
    /* Allocate ua, va, and fa here */
    for (level = 0; level < nlevels; level++)
    {
@@ -234,6 +247,27 @@ _braid_InitHierarchy(braid_Core    core,
       _braid_GridElt(grid, nupoints)  = nupoints;
       _braid_GridElt(grid, ua_alloc)  = ua;
       _braid_GridElt(grid, ua)        = ua+1;  /* shift */
+
+      /* Packed C-points, in reduced precision, or out of core or as deltas on
+       * level 0 (BufPack and BufUnpack are not recorded for the adjoint, and
+       * shells cannot be packed) */
+      delta = (level == 0) && (_braid_CoreElt(core, delta_keyframe) > 0);
+      if ( ( ((_braid_CoreElt(core, reduced_storage) > -1) &&
+              (level >= _braid_CoreElt(core, reduced_storage))) ||
+             ((_braid_CoreElt(core, ooc_path) != NULL) && (level == 0)) || delta ) &&
+           !_braid_CoreElt(core, adjoint) && (_braid_CoreElt(core, useshell)!=1) )
+      {
+         _braid_GridElt(grid, upack) = _braid_CTAlloc(void *, nupoints);
+         if (delta)
+         {
+            _braid_GridElt(grid, uref) =
+               _braid_CTAlloc(void *, nupoints/_braid_CoreElt(core, delta_keyframe) + 1);
+         }
+         else if (level == 0)
+         {
+            _braid_OocInit(core);
+         }
+      }
    }
 
    /* Communicate ta[-1] and ta[iupper-ilower+1] information */
@@ -299,6 +333,18 @@ _braid_InitHierarchy(braid_Core    core,
       }
    }
 
+   /* Set up persistent requests for the neighbor exchange on each level */
+   if (_braid_CoreElt(core, persistent_comm))
+   {
+      for (level = 0; level < nlevels; level++)
+      {
+         _braid_CommPersistentInit(core, level);
+      }
+   }
+
+   /* Exchange with neighbors on the same node through shared memory */
+   _braid_ShmInit(core);
+
    return _braid_error_flag;
 }
 
@@ -352,8 +398,11 @@ _braid_InitGuess(braid_Core  core,
    braid_BaseVector  u;
    braid_Int         i, iu, sflag;
 
+   _braid_SetCallLevel(level, NULL);
    if ( (level == 0) && (seq_soln == 1) )
    {
+      _braid_CoreElt(core, comm_phase) = _braid_PhaseInit;
+
       /* If first processor, grab initial condition */
       if(ilower == 0)
       {
@@ -457,6 +506,7 @@ _braid_CopyFineToCoarse(braid_Core  core)
 
    for(level = 1; level < nlevels; level++)
    {
+      _braid_SetCallLevel(level, NULL);
 
       f_cfactor = _braid_GridElt(grids[level-1], cfactor);
       iupper    = _braid_GridElt(grids[level], iupper);
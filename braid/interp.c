@@ -23,60 +23,60 @@
 #include "util.h"
 
 /*----------------------------------------------------------------------------
- * F-Relax on level and interpolate to level-1
+ * F-relaxation of one interval and interpolation of its points to level-1
+ * (see _braid_IntervalFcn)
  *----------------------------------------------------------------------------*/
 
-braid_Int
-_braid_FInterp(braid_Core  core,
-               braid_Int   level)
+static braid_Int
+_braid_FInterpInterval(braid_Core  core,
+                       braid_Int   level,
+                       braid_Int   interval,
+                       void       *data)
 {
    braid_App            app          = _braid_CoreElt(core, app);
    _braid_Grid        **grids        = _braid_CoreElt(core, grids);
-   braid_AccessStatus   astatus      = (braid_AccessStatus)core;
+   _braid_AccessStatus  astatus_s;
+   braid_AccessStatus   astatus      = &astatus_s;
    braid_Int            iter         = _braid_CoreElt(core, niter);
    braid_Int            access_level = _braid_CoreElt(core, access_level);
    braid_Int            nrefine      = _braid_CoreElt(core, nrefine);
    braid_Int            gupper       = _braid_CoreElt(core, gupper);
    braid_Int            ilower       = _braid_GridElt(grids[level], ilower);
-   braid_Int            ncpoints     = _braid_GridElt(grids[level], ncpoints);
    braid_BaseVector    *va           = _braid_GridElt(grids[level], va);
    braid_Real          *ta           = _braid_GridElt(grids[level], ta);
-   
+   braid_Int            f_level      = level-1;
+   braid_Int            f_cfactor    = _braid_GridElt(grids[f_level], cfactor);
+
    braid_Real         rnorm;
-   braid_Int          f_level, f_cfactor, f_index;
-   braid_BaseVector       f_u, f_e;
+   braid_Int          f_index;
+   braid_BaseVector   f_u, f_e;
 
-   braid_BaseVector       u, e;
+   braid_BaseVector   u, e, ustop;
    braid_Int          flo, fhi, fi, ci;
-   braid_Int          interval;
 
-   f_level   = level-1;
-   f_cfactor = _braid_GridElt(grids[f_level], cfactor);
+   _braid_StatusInit(core, (braid_Status) astatus);
 
    _braid_GetRNorm(core, -1, &rnorm);
-   
-   _braid_UCommInitF(core, level);
 
-   /**
-    * Start from the right-most interval 
-    *
-    * First, generate the coarse-grid F-points through F-relaxation and
-    * interpolate them to the fine grid, where they are C-points.  Second,
-    * interpolate the coarse-grid C-points to the fine-grid.  The user-defined
-    * spatial refinement (if set) is also called.  
-    **/
-   for (interval = ncpoints; interval > -1; interval--)
-   {
-      _braid_GetInterval(core, level, interval, &flo, &fhi, &ci);
+   _braid_GetInterval(core, level, interval, &flo, &fhi, &ci);
 
-      /* Relax and interpolate F-points, refining in space if needed */
+   /* Relax and interpolate F-points, refining in space if needed */
+   _braid_Critical
+   {
       if (flo <= fhi)
       {
          _braid_UGetVector(core, level, flo-1, &u);
       }
-      for (fi = flo; fi <= fhi; fi++)
+   }
+   for (fi = flo; fi <= fhi; fi++)
+   {
+      _braid_Critical
+      {
+         _braid_GetUInit(core, level, fi, u, &ustop);
+      }
+      _braid_Step(core, level, fi, ustop, u);
+      _braid_Critical
       {
-         _braid_Step(core, level, fi, NULL, u);
          _braid_USetVector(core, level, fi, u, 0);
          /* Allow user to process current vector */
          if( (access_level >= 3) )
@@ -88,11 +88,21 @@ _braid_FInterp(braid_Core  core,
          e = va[fi-ilower];
          _braid_BaseSum(core, app,  1.0, u, -1.0, e);
          _braid_MapCoarseToFine(fi, f_cfactor, f_index);
-         _braid_Refine(core, f_level, f_index, fi, e, &f_e);
+         /* The correction of the fine vector is charged to f_level */
+         _braid_SetCallLevel(f_level, NULL);
          _braid_UGetVectorRef(core, f_level, f_index, &f_u);
-         _braid_BaseSum(core, app,  1.0, f_e, 1.0, f_u);
+         if (_braid_CoreElt(core, scoarsen) == NULL)
+         {
+            /* No spatial refinement, so correct with e directly */
+            _braid_BaseSum(core, app,  1.0, e, 1.0, f_u);
+         }
+         else
+         {
+            _braid_Refine(core, f_level, f_index, fi, e, &f_e);
+            _braid_BaseSum(core, app,  1.0, f_e, 1.0, f_u);
+            _braid_BaseFree(core, app,  f_e);
+         }
          _braid_USetVectorRef(core, f_level, f_index, f_u);
-         _braid_BaseFree(core, app,  f_e);
          /* Allow user to process current vector on the FINEST level*/
          if( (access_level >= 3) && (f_level == 0) )
          {
@@ -100,14 +110,22 @@ _braid_FInterp(braid_Core  core,
                                     0, 0, braid_ASCaller_FInterp, astatus);
             _braid_AccessVector(core, astatus, f_u);
          }
-
+         /* Pack the corrected fine-grid C-point again (if stored packed) */
+         _braid_URepack(core, f_level, f_index, f_index);
+         _braid_SetCallLevel(level, NULL);
       }
+   }
+   _braid_Critical
+   {
       if (flo <= fhi)
       {
          _braid_BaseFree(core, app,  u);
       }
+   }
 
-      /* Interpolate C-points, refining in space if needed */
+   /* Interpolate C-points, refining in space if needed */
+   _braid_Critical
+   {
       if (ci > _braid_CoreElt(core, initiali))
       {
          _braid_UGetVectorRef(core, level, ci, &u);
@@ -121,11 +139,21 @@ _braid_FInterp(braid_Core  core,
          e = va[ci-ilower];
          _braid_BaseSum(core, app,  1.0, u, -1.0, e);
          _braid_MapCoarseToFine(ci, f_cfactor, f_index);
-         _braid_Refine(core, f_level, f_index, ci, e, &f_e);
+         /* The correction of the fine vector is charged to f_level */
+         _braid_SetCallLevel(f_level, NULL);
          _braid_UGetVectorRef(core, f_level, f_index, &f_u);
-         _braid_BaseSum(core, app,  1.0, f_e, 1.0, f_u);
+         if (_braid_CoreElt(core, scoarsen) == NULL)
+         {
+            /* No spatial refinement, so correct with e directly */
+            _braid_BaseSum(core, app,  1.0, e, 1.0, f_u);
+         }
+         else
+         {
+            _braid_Refine(core, f_level, f_index, ci, e, &f_e);
+            _braid_BaseSum(core, app,  1.0, f_e, 1.0, f_u);
+            _braid_BaseFree(core, app,  f_e);
+         }
          _braid_USetVectorRef(core, f_level, f_index, f_u);
-         _braid_BaseFree(core, app,  f_e);
          /* Allow user to process current C-point on the FINEST level*/
          if( (access_level >= 3) && (f_level == 0) )
          {
@@ -133,15 +161,58 @@ _braid_FInterp(braid_Core  core,
                                     0, 0, braid_ASCaller_FInterp, astatus);
             _braid_AccessVector(core, astatus, f_u);
          }
+         /* Pack the corrected fine-grid C-point again (if stored packed) */
+         _braid_URepack(core, f_level, f_index, f_index);
+         _braid_SetCallLevel(level, NULL);
+      }
+   }
 
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ * F-Relax on level and interpolate to level-1
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_FInterp(braid_Core  core,
+               braid_Int   level)
+{
+   _braid_Grid        **grids        = _braid_CoreElt(core, grids);
+   braid_Int            ncpoints     = _braid_GridElt(grids[level], ncpoints);
+
+   braid_Int          interval, tlo, thi;
+
+   _braid_CoreElt(core, comm_phase) = _braid_PhaseInterp;
+   _braid_SetCallLevel(level, NULL);
+   _braid_ThreadIntervals(core, level, &tlo, &thi);
+   _braid_UCommInitF(core, level);
+
+   /**
+    * Start from the right-most interval 
+    *
+    * First, generate the coarse-grid F-points through F-relaxation and
+    * interpolate them to the fine grid, where they are C-points.  Second,
+    * interpolate the coarse-grid C-points to the fine-grid.  The user-defined
+    * spatial refinement (if set) is also called.  
+    **/
+   for (interval = ncpoints; interval > -1; interval--)
+   {
+      if (interval == thi)
+      {
+         /* Do the intervals in between with threads */
+         _braid_ThreadLoop(core, level, tlo, thi, _braid_FInterpInterval, NULL);
+         interval = tlo;
+         continue;
       }
+      _braid_FInterpInterval(core, level, interval, NULL);
    }
 
    _braid_UCommWait(core, level);
 
    /* Clean up */
+   _braid_GridMemory(core, grids[level]);   /* record the peak before cleaning */
    _braid_GridClean(core, grids[level]);
 
    return _braid_error_flag;
 }
-
@@ -181,7 +181,8 @@ _braid_ComputeFullRNorm(braid_Core  core,
    braid_Real         tol         = _braid_CoreElt(core, tol);
    braid_Int          iter        = _braid_CoreElt(core, niter);
    _braid_Grid      **grids       = _braid_CoreElt(core, grids);
-   braid_StepStatus   status      = (braid_StepStatus)core;
+   _braid_StepStatus  status_s;
+   braid_StepStatus   status      = &status_s;
    braid_Int          nrefine     = _braid_CoreElt(core, nrefine);
    braid_Int          ncpoints    = _braid_GridElt(grids[level], ncpoints);
    braid_Int          gupper      = _braid_CoreElt(core, gupper);
@@ -195,6 +196,10 @@ _braid_ComputeFullRNorm(braid_Core  core,
    braid_Real        rnorm_temp, rnorm = 0, global_rnorm = 0;
    braid_BaseVector  u, r;
 
+   _braid_StatusInit(core, (braid_Status) status);
+
+   _braid_CoreElt(core, comm_phase) = _braid_PhaseResidual;
+   _braid_SetCallLevel(level, NULL);
    _braid_UCommInit(core, level);
 
    /* Start from the right-most interval. */
@@ -213,13 +218,14 @@ _braid_ComputeFullRNorm(braid_Core  core,
       /* Generate F-points and get residual. */
       for (fi = flo; fi <= fhi; fi++)
       {
-         _braid_BaseClone(core, app,  u, &r);
+         _braid_GridScratch(core, grids[level], u, &r);
          _braid_Step(core, level, fi, NULL, u);
 
          /* Update local processor norm. */
          ii = fi-ilower;
          _braid_StepStatusInit(ta[ii-1], ta[ii], fi-1, tol, iter, level, nrefine, gupper, status);
          _braid_BaseFullResidual(core, app, u, r, status);
+         _braid_StepStatusDone(status);
          _braid_BaseSpatialNorm(core, app,  r, &rnorm_temp); 
          if(tnorm == 1)       /* one-norm */ 
          {  
@@ -244,7 +250,7 @@ _braid_ComputeFullRNorm(braid_Core  core,
             _braid_GridElt(grids[level], send_index)  = _braid_SendIndexNull;
             _braid_GridElt(grids[level], send_handle) = send_handle;
          }
-         _braid_BaseFree(core, app,  r);
+         _braid_GridScratchFree(core, grids[level], r);
       }
       /* Residual from C-point. */
       if (ci > _braid_CoreElt(core, initiali))
@@ -254,6 +260,7 @@ _braid_ComputeFullRNorm(braid_Core  core,
          _braid_StepStatusInit(ta[ii-1], ta[ii], ci-1, tol, iter, level, nrefine, gupper, status);
          _braid_UGetVector(core, level, ci, &r);
          _braid_BaseFullResidual(core, app, r, u, status);
+         _braid_StepStatusDone(status);
          _braid_BaseSpatialNorm(core, app,  u, &rnorm_temp);
 
          if(tnorm == 1)       /* one-norm */ 
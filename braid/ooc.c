@@ -0,0 +1,379 @@
+/*BHEADER**********************************************************************
+ * Copyright (c) 2013, Lawrence Livermore National Security, LLC.
+ * Produced at the Lawrence Livermore National Laboratory.
+ *
+ * This file is part of XBraid. For support, post issues to the XBraid Github page.
+ *
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License (as published by the Free Software
+ * Foundation) version 2.1 dated February 1999.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the IMPLIED WARRANTY OF MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE. See the terms and conditions of the GNU General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc., 59
+ * Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+ ***********************************************************************EHEADER*/
+
+/** \file ooc.c
+ * \brief Source code for out-of-core storage of the level 0 C-points.  See
+ * braid_SetOutOfCore() for more information.
+ *
+ * The C-points are packed as for reduced precision storage (see uvector.c)
+ * and written to a per-processor file, at a fixed offset for each point.  A
+ * point is read back when needed.  Each read then starts an asynchronous read
+ * (POSIX aio) of the next point to the left into a read-ahead buffer, since
+ * the relaxation, restriction and interpolation visit the intervals from right
+ * to left.  A later fetch of that point takes the buffer, waiting for the read
+ * only if it is not done yet.  There are _braid_OocNAhead buffers, so a read
+ * ahead survives a fetch of another point (e.g., the point to the right of an
+ * interval).  A read-ahead is dropped when its point is written again or the
+ * grid is rebuilt.  Without aio, all reads are synchronous.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "_braid.h"
+#include "util.h"
+
+#if defined(_POSIX_ASYNCHRONOUS_IO) && (_POSIX_ASYNCHRONOUS_IO > 0)
+#define _braid_OOC_AIO 1
+#include <aio.h>
+#include <errno.h>
+#else
+#define _braid_OOC_AIO 0
+#endif
+
+/*----------------------------------------------------------------------------
+ * The read-ahead buffers (pointed to by the core element ooc_ahead)
+ *----------------------------------------------------------------------------*/
+
+typedef struct
+{
+   braid_Int      iu;       /* point being read, -1 if none */
+   braid_Int      size;     /* bytes being read */
+   void          *buffer;   /* buffer being read into */
+#if _braid_OOC_AIO
+   struct aiocb   cb;       /* pending request */
+#endif
+
+} _braid_OocRead;
+
+typedef struct
+{
+   _braid_OocRead  reads[_braid_OocNAhead];
+   braid_Int       next;    /* buffer to reuse next if all are busy */
+
+} _braid_OocAhead;
+
+/*----------------------------------------------------------------------------
+ * Waits for a read-ahead.  If 'buffer_ptr' is not NULL, the buffer is returned
+ * in it if the read succeeded (NULL otherwise), else the buffer is freed.
+ *----------------------------------------------------------------------------*/
+
+static braid_Int
+_braid_OocReadWait(_braid_OocRead   *req,
+                   void            **buffer_ptr)
+{
+   void  *buffer = NULL;
+
+#if _braid_OOC_AIO
+   const struct aiocb  *list[1];
+
+   list[0] = &(req->cb);
+   while (aio_error(&(req->cb)) == EINPROGRESS)
+   {
+      aio_suspend(list, 1, NULL);
+   }
+   if ( (aio_return(&(req->cb)) == req->size) && (buffer_ptr != NULL) )
+   {
+      buffer = req->buffer;
+   }
+#endif
+   if (buffer == NULL)
+   {
+      free(req->buffer);
+   }
+   if (buffer_ptr != NULL)
+   {
+      *buffer_ptr = buffer;
+   }
+   req->iu     = -1;
+   req->buffer = NULL;
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ * Drops the read-ahead of point 'iu', or of all points if 'iu' is negative
+ *----------------------------------------------------------------------------*/
+
+static braid_Int
+_braid_OocAheadDrop(braid_Core  core,
+                    braid_Int   iu)
+{
+   _braid_OocAhead  *ahead = _braid_CoreElt(core, ooc_ahead);
+   braid_Int         i;
+
+   for (i = 0; i < _braid_OocNAhead; i++)
+   {
+      if ( (ahead->reads[i].iu > -1) && ((iu < 0) || (ahead->reads[i].iu == iu)) )
+      {
+         _braid_OocReadWait(&(ahead->reads[i]), NULL);
+      }
+   }
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ * Returns the read-ahead buffer of point 'iu' in 'buffer_ptr', after its read
+ * is done, or NULL if the point was not read ahead
+ *----------------------------------------------------------------------------*/
+
+static braid_Int
+_braid_OocAheadTake(braid_Core   core,
+                    braid_Int    iu,
+                    void       **buffer_ptr)
+{
+   _braid_OocAhead  *ahead = _braid_CoreElt(core, ooc_ahead);
+   braid_Int         i;
+
+   *buffer_ptr = NULL;
+   for (i = 0; i < _braid_OocNAhead; i++)
+   {
+      if (ahead->reads[i].iu == iu)
+      {
+         _braid_OocReadWait(&(ahead->reads[i]), buffer_ptr);
+      }
+   }
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ * Starts reading point 'iu' (of 'size' bytes) ahead, unless it already is.  If
+ * all buffers are busy, the oldest read is dropped.
+ *----------------------------------------------------------------------------*/
+
+static braid_Int
+_braid_OocAheadStart(braid_Core  core,
+                     braid_Int   iu,
+                     braid_Int   size)
+{
+#if _braid_OOC_AIO
+   _braid_OocAhead  *ahead = _braid_CoreElt(core, ooc_ahead);
+   _braid_OocRead   *req;
+   braid_Int         i, ifree;
+
+   ifree = ahead->next;
+   for (i = _braid_OocNAhead-1; i > -1; i--)
+   {
+      if (ahead->reads[i].iu == iu)
+      {
+         return _braid_error_flag;
+      }
+      if (ahead->reads[i].iu < 0)
+      {
+         ifree = i;
+      }
+   }
+   req = &(ahead->reads[ifree]);
+   if (req->iu > -1)
+   {
+      _braid_OocReadWait(req, NULL);
+   }
+   ahead->next = (ifree + 1) % _braid_OocNAhead;
+
+   memset(&(req->cb), 0, sizeof(struct aiocb));
+   req->buffer                        = malloc(size);
+   req->cb.aio_fildes                 = _braid_CoreElt(core, ooc_fd);
+   req->cb.aio_offset                 = (off_t) iu * _braid_CoreElt(core, ooc_slot_size);
+   req->cb.aio_buf                    = req->buffer;
+   req->cb.aio_nbytes                 = size;
+   req->cb.aio_sigevent.sigev_notify  = SIGEV_NONE;
+   if (aio_read(&(req->cb)) == 0)
+   {
+      req->iu   = iu;
+      req->size = size;
+   }
+   else
+   {
+      /* The point is read synchronously when it is fetched */
+      _braid_TFree(req->buffer);
+   }
+#endif
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_OocInit(braid_Core  core)
+{
+   braid_App            app     = _braid_CoreElt(core, app);
+   _braid_Grid        **grids   = _braid_CoreElt(core, grids);
+   char                *path    = _braid_CoreElt(core, ooc_path);
+   _braid_BufferStatus  bstatus_s;
+   braid_BufferStatus   bstatus = &bstatus_s;
+   _braid_OocAhead     *ahead;
+   braid_Int            size, i;
+   char                *filename;
+   int                  fd;
+
+   _braid_StatusInit(core, (braid_Status) bstatus);
+
+   if (path == NULL)
+   {
+      return _braid_error_flag;
+   }
+
+   if (_braid_CoreElt(core, ooc_fd) < 0)
+   {
+      /* The file is unlinked right away, so it is removed on exit */
+      filename = _braid_TAlloc(char, strlen(path) + 16);
+      sprintf(filename, "%s.%d", path, _braid_CoreElt(core, myid_world));
+      fd = open(filename, O_RDWR | O_CREAT | O_TRUNC, 0600);
+      if (fd < 0)
+      {
+         _braid_Error(braid_ERROR_GENERIC, "Unable to open the out-of-core file");
+         _braid_TFree(filename);
+         return _braid_error_flag;
+      }
+      unlink(filename);
+      _braid_TFree(filename);
+      _braid_CoreElt(core, ooc_fd) = fd;
+
+      /* Points that do not fit a slot stay in memory */
+      _braid_BufferStatusInit( 0, 0, bstatus );
+      _braid_BaseBufSize(core, app,  &size, bstatus);
+      _braid_ReducedBound(size, &size);
+      _braid_CoreElt(core, ooc_slot_size) = size;
+
+      ahead = _braid_CTAlloc(_braid_OocAhead, 1);
+      for (i = 0; i < _braid_OocNAhead; i++)
+      {
+         ahead->reads[i].iu = -1;
+      }
+      _braid_CoreElt(core, ooc_ahead) = ahead;
+   }
+
+   /* The point indices change with the new grid */
+   _braid_OocAheadDrop(core, -1);
+
+   _braid_GridElt(grids[0], uspill) =
+      _braid_CTAlloc(braid_Int, _braid_GridElt(grids[0], nupoints));
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_OocDestroy(braid_Core  core)
+{
+   if (_braid_CoreElt(core, ooc_fd) > -1)
+   {
+      _braid_OocAheadDrop(core, -1);
+      _braid_TFree(_braid_CoreElt(core, ooc_ahead));
+      close(_braid_CoreElt(core, ooc_fd));
+      _braid_CoreElt(core, ooc_fd) = -1;
+   }
+   _braid_TFree(_braid_CoreElt(core, ooc_path));
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_OocSpill(braid_Core   core,
+                braid_Int    level,
+                braid_Int    iu,
+                braid_Int    size,
+                void       **slot_ptr)
+{
+   _braid_Grid  **grids     = _braid_CoreElt(core, grids);
+   braid_Int     *uspill    = _braid_GridElt(grids[level], uspill);
+   braid_Int      slot_size = _braid_CoreElt(core, ooc_slot_size);
+   int            fd        = _braid_CoreElt(core, ooc_fd);
+   off_t          offset    = (off_t) iu * slot_size;
+
+   if ( (uspill == NULL) || (fd < 0) || (iu < _braid_CoreElt(core, ooc_window)) ||
+        (size > slot_size) )
+   {
+      return _braid_error_flag;
+   }
+
+   /* Drop a read-ahead of the old value of this point */
+   _braid_OocAheadDrop(core, iu);
+
+   if (pwrite(fd, *slot_ptr, size, offset) != size)
+   {
+      /* Keep the point in memory if the write failed (e.g., disk full) */
+      return _braid_error_flag;
+   }
+   _braid_CoreElt(core, ooc_stats)[0] += size;
+   uspill[iu] = size;
+   _braid_TFree(*slot_ptr);
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_OocFetch(braid_Core   core,
+                braid_Int    level,
+                braid_Int    iu,
+                void       **packed_ptr)
+{
+   _braid_Grid  **grids     = _braid_CoreElt(core, grids);
+   braid_Int     *uspill    = _braid_GridElt(grids[level], uspill);
+   braid_Int      slot_size = _braid_CoreElt(core, ooc_slot_size);
+   int            fd        = _braid_CoreElt(core, ooc_fd);
+   void          *packed    = NULL;
+   braid_Real     localtime;
+
+   if ( (uspill != NULL) && (uspill[iu] > 0) )
+   {
+      /* Take the read-ahead buffer if it holds this point, else read it now */
+      localtime = MPI_Wtime();
+      _braid_OocAheadTake(core, iu, &packed);
+      if (packed != NULL)
+      {
+         _braid_CoreElt(core, ooc_stats)[3] += uspill[iu];
+      }
+      else
+      {
+         packed = malloc(uspill[iu]);
+         if (pread(fd, packed, uspill[iu], (off_t) iu * slot_size) != uspill[iu])
+         {
+            _braid_Error(braid_ERROR_GENERIC, "Unable to read from the out-of-core file");
+         }
+      }
+      _braid_CoreElt(core, ooc_stats)[1] += uspill[iu];
+      _braid_CoreElt(core, ooc_stats)[2] += MPI_Wtime() - localtime;
+
+      /* Start reading the next point in the background */
+      if ( (iu > 0) && (uspill[iu-1] > 0) )
+      {
+         _braid_OocAheadStart(core, iu-1, uspill[iu-1]);
+      }
+   }
+
+   *packed_ptr = packed;
+
+   return _braid_error_flag;
+}
@@ -242,9 +242,12 @@ _braid_FRefine(braid_Core   core,
    braid_Int          nrefine         = _braid_CoreElt(core, nrefine);
    braid_Int          max_refinements = _braid_CoreElt(core, max_refinements);
    braid_Int          tpoints_cutoff  = _braid_CoreElt(core, tpoints_cutoff);
-   braid_AccessStatus astatus         = (braid_AccessStatus)core;
-   braid_BufferStatus bstatus         = (braid_BufferStatus)core;
-   braid_SyncStatus   sstatus         = (braid_SyncStatus)core;
+   _braid_AccessStatus astatus_s;
+   braid_AccessStatus  astatus        = &astatus_s;
+   _braid_BufferStatus bstatus_s;
+   braid_BufferStatus  bstatus        = &bstatus_s;
+   _braid_SyncStatus  sstatus_s;
+   braid_SyncStatus   sstatus         = &sstatus_s;
    braid_Int          access_level    = _braid_CoreElt(core, access_level);
    _braid_Grid      **grids           = _braid_CoreElt(core, grids);
    braid_Int          ncpoints        = _braid_GridElt(grids[0], ncpoints);
@@ -275,6 +278,10 @@ _braid_FRefine(braid_Core   core,
    braid_Int         cfactor, rfactor, m, interval, flo, fhi, fi, ci, f_hi, f_ci;
    braid_Real       *rdtvalue;
 
+   _braid_StatusInit(core, (braid_Status) astatus);
+   _braid_StatusInit(core, (braid_Status) bstatus);
+   _braid_StatusInit(core, (braid_Status) sstatus);
+
 #if DEBUG
    /*cfactor = 6;*/ /* RDF HACKED TEST */
 #endif
@@ -641,6 +648,8 @@ _braid_FRefine(braid_Core   core,
 
    _braid_GetRNorm(core, -1, &rnorm);
 
+   _braid_CoreElt(core, comm_phase) = _braid_PhaseRefine;
+   _braid_SetCallLevel(0, NULL);
    _braid_UCommInitF(core, 0);
 
    /* Start from the right-most interval */
@@ -949,6 +958,8 @@ _braid_FRefine(braid_Core   core,
    {
       send_msg = 1;
    }
+   _braid_CoreElt(core, comm_phase) = _braid_PhaseRefine;
+   _braid_SetCallLevel(0, NULL);
    _braid_UCommInitBasic(core, 0, recv_msg, send_msg, 0);
 
 #if DEBUG
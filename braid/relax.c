@@ -19,89 +19,490 @@
  *
  ***********************************************************************EHEADER*/
 
+#include <string.h>
 #include "_braid.h"
 #include "util.h"
 
 /*----------------------------------------------------------------------------
- * Do nu sweeps of F-then-C relaxation
+ * Relaxation sweep state.  An FC-sweep does F-then-C relaxation of each
+ * interval.  A C-sweep relaxes the C-points again from the last F-points of
+ * the FC-sweep before it, which are kept in *fkeep* (indexed by interval).
  *----------------------------------------------------------------------------*/
 
-braid_Int
-_braid_FCRelax(braid_Core  core,
-               braid_Int   level)
+typedef struct
 {
-   braid_App       app      = _braid_CoreElt(core, app);
-   braid_Int       nlevels  = _braid_CoreElt(core, nlevels);
-   braid_Int      *nrels    = _braid_CoreElt(core, nrels);
-   braid_Real     *CWts     = _braid_CoreElt(core, CWts);
-   _braid_Grid   **grids    = _braid_CoreElt(core, grids);
-   braid_Int       ncpoints = _braid_GridElt(grids[level], ncpoints);
+   braid_BaseVector  *ustart;   /* start vectors of the thread blocks, or NULL */
+   braid_BaseVector  *fkeep;    /* last F-point of each interval, or NULL */
+   braid_Int          fsweep;   /* boolean, do F-relaxation before C-relaxation */
+   braid_Real         CWt;      /* C-relaxation weight */
 
-   braid_BaseVector  u, u_old;
-   braid_Real        CWt;
-   braid_Int         flo, fhi, fi, ci;
-   braid_Int         nu, nrelax, interval;
+} _braid_RelaxSweep;
 
-   nrelax  = nrels[level];
-   CWt     = CWts[level];
+/*----------------------------------------------------------------------------
+ * Get the vector that relaxation of an interval starts from (NULL if the
+ * interval has no points to relax)
+ *----------------------------------------------------------------------------*/
 
-   for (nu = 0; nu < nrelax; nu++)
+static braid_Int
+_braid_FCRelaxStart(braid_Core          core,
+                    braid_Int           level,
+                    braid_Int           interval,
+                    _braid_RelaxSweep  *sweep,
+                    braid_BaseVector   *u_ptr)
+{
+   braid_App  app = _braid_CoreElt(core, app);
+   braid_Int  flo, fhi, ci;
+
+   _braid_GetInterval(core, level, interval, &flo, &fhi, &ci);
+
+   *u_ptr = NULL;
+   if ( (flo <= fhi) && !sweep->fsweep )
+   {
+      _braid_BaseClone(core, app, sweep->fkeep[interval], u_ptr);
+   }
+   else if (flo <= fhi)
+   {
+      _braid_UGetVector(core, level, flo-1, u_ptr);
+   }
+   else if (ci > _braid_CoreElt(core, initiali))
    {
-      _braid_UCommInit(core, level);
+      _braid_UGetVector(core, level, ci-1, u_ptr);
+   }
 
-      /* Start from the right-most interval */
-      for (interval = ncpoints; interval > -1; interval--)
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ * Relaxation of one interval (see _braid_IntervalFcn) in the sweep *data*.
+ *----------------------------------------------------------------------------*/
+
+static braid_Int
+_braid_FCRelaxInterval(braid_Core  core,
+                       braid_Int   level,
+                       braid_Int   interval,
+                       void       *data)
+{
+   braid_App           app      = _braid_CoreElt(core, app);
+   braid_Int           nlevels  = _braid_CoreElt(core, nlevels);
+   _braid_Grid       **grids    = _braid_CoreElt(core, grids);
+   _braid_RelaxSweep  *sweep    = (_braid_RelaxSweep *) data;
+   braid_Real          CWt      = sweep->CWt;
+
+   braid_BaseVector    u = NULL, ustop, u_old, v;
+   braid_Int           flo, fhi, fi, ci, cpoint;
+
+   _braid_GetInterval(core, level, interval, &flo, &fhi, &ci);
+   cpoint = (ci > _braid_CoreElt(core, initiali));
+
+   if (sweep->ustart != NULL)
+   {
+      u = sweep->ustart[interval];
+      sweep->ustart[interval] = NULL;
+   }
+   if (u == NULL)
+   {
+      _braid_Critical
       {
-         _braid_GetInterval(core, level, interval, &flo, &fhi, &ci);
+         _braid_FCRelaxStart(core, level, interval, sweep, &u);
+      }
+   }
 
-         if (flo <= fhi)
+   if (sweep->fsweep)
+   {
+      /* F-relaxation.  Without a C-point to relax next, u is moved into the
+       * last F-point instead of copied and freed */
+      for (fi = flo; fi <= fhi; fi++)
+      {
+         _braid_Critical
          {
-            _braid_UGetVector(core, level, flo-1, &u);
+            _braid_GetUInit(core, level, fi, u, &ustop);
          }
-         else if (ci > _braid_CoreElt(core, initiali))
+         _braid_Step(core, level, fi, ustop, u);
+         _braid_Critical
          {
-            _braid_UGetVector(core, level, ci-1, &u);
+            if ( (fi == fhi) && (sweep->fkeep != NULL) )
+            {
+               /* Keep the last F-point for the C-sweeps that follow */
+               if (sweep->fkeep[interval] != NULL)
+               {
+                  _braid_BaseFree(core, app, sweep->fkeep[interval]);
+               }
+               _braid_BaseClone(core, app, u, &sweep->fkeep[interval]);
+            }
+            _braid_USetVector(core, level, fi, u, (fi == fhi) && !cpoint);
          }
+      }
+   }
+   else if (flo <= fhi)
+   {
+      /* The F-points are unchanged, but the last one is still sent to the
+       * right neighbor, and the one received from the left is not needed */
+      _braid_Critical
+      {
+         if (fhi == _braid_GridElt(grids[level], send_index))
+         {
+            _braid_USetVector(core, level, fhi, u, 0);
+         }
+         if ((flo-1) == _braid_GridElt(grids[level], recv_index))
+         {
+            _braid_UGetVector(core, level, flo-1, &v);
+            if (v != NULL)
+            {
+               _braid_BaseFree(core, app, v);
+            }
+         }
+         if (!cpoint)
+         {
+            _braid_BaseFree(core, app, u);
+         }
+      }
+   }
+
+   /* C-relaxation */
+   if (cpoint)
+   {
+      _braid_Critical
+      {
+         _braid_GetUInit(core, level, ci, u, &ustop);
+      }
+      _braid_Step(core, level, ci, ustop, u);
+
+      _braid_Critical
+      {
+         /* If weighted Jacobi, combine with the previous u-value, which is
+          * still stored at ci and is freed when u is moved there below.
+          *   Note, do no weighting if coarsest level*/
+         if( (CWt != 1.0) && (level != (nlevels-1)) )
+         {
+            /* Apply weighted combination for w-Jacobi
+             * u <--  omega*u_new + (1-omega)*u_old */
+            _braid_UGetVectorRef(core, level, ci, &u_old);
+            _braid_BaseSum(core, app, (1.0 - CWt), u_old, CWt, u);
+         }
+
+         _braid_USetVector(core, level, ci, u, 1);
+      }
+   }
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ * Make progress on the messages of *level* until the receive (recv = 1) or
+ * the send (recv = 0) is done.  This is called by the master thread while
+ * tasks run on the other threads, so the messages are only touched in
+ * _braid_Critical sections.
+ *----------------------------------------------------------------------------*/
+
+static braid_Int
+_braid_FCRelaxCommWait(braid_Core  core,
+                       braid_Int   level,
+                       braid_Int   recv)
+{
+   _braid_Grid  **grids     = _braid_CoreElt(core, grids);
+   braid_Real     wait_time = MPI_Wtime();
+   braid_Int      done      = 0;
+
+   while (!done)
+   {
+      _braid_Critical
+      {
+         _braid_UCommProgress(core, level);
+         if (recv)
+         {
+            done = (_braid_GridElt(grids[level], recv_handle) == NULL);
+         }
+         else
+         {
+            done = (_braid_GridElt(grids[level], send_handle) == NULL);
+         }
+      }
+      if (!done)
+      {
+#ifdef _OPENMP
+#pragma omp taskyield
+#endif
+      }
+   }
+   if (recv)
+   {
+      _braid_CoreElt(core, recv_wait)[level] += MPI_Wtime() - wait_time;
+   }
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ * Do the sweeps of relaxation on *level* as a task graph, with the intervals
+ * [tlo, thi] in between split into blocks.  Each sweep has three kinds of
+ * tasks:
+ *
+ *   - the right-most intervals, which hold the point sent to the right
+ *     neighbor, and the left-most interval, which needs the point received
+ *     from the left neighbor.  These are done by the master thread (which
+ *     makes all MPI calls) as undeferred tasks.
+ *   - the start vector of each block, a copy of the C-point to its left (or
+ *     of its kept F-point in a C-sweep)
+ *   - the relaxation of each block, from right to left
+ *
+ * The dependencies are those of the sequential sweeps.  A block is relaxed
+ * after its own relaxation in the previous sweep and after its start was
+ * copied, and it overwrites its right-most C-point only after the block on its
+ * right has copied that point as its start.  So there is no barrier between
+ * sweeps: a block starts the next sweep as soon as its neighbors are done, and
+ * the interior keeps the threads busy while the master waits on messages.  The
+ * result is the same as with the sequential sweeps.
+ *----------------------------------------------------------------------------*/
+
+static braid_Int
+_braid_FCRelaxTasks(braid_Core          core,
+                    braid_Int           level,
+                    braid_Int           tlo,
+                    braid_Int           thi,
+                    _braid_RelaxSweep  *sweeps,
+                    braid_Int           nsweeps)
+{
+   _braid_Grid      **grids    = _braid_CoreElt(core, grids);
+   braid_Int          ncpoints = _braid_GridElt(grids[level], ncpoints);
+
+   braid_BaseVector  *ustart;
+   char              *dep, *sdep;
+   braid_Int          nblocks;
 
-         /* F-relaxation */
-         for (fi = flo; fi <= fhi; fi++)
+   /* Dependency tokens: dep[0] for the left-most interval, dep[b+1] for block
+    * b, dep[nblocks+1] for the right-most intervals, and sdep[b+1] for the
+    * start vector of block b */
+   _braid_ThreadBlocks(tlo, thi, &nblocks);
+   dep    = _braid_CTAlloc(char, nblocks+2);
+   sdep   = _braid_CTAlloc(char, nblocks+2);
+   ustart = _braid_CTAlloc(braid_BaseVector, ncpoints+1);
+
+#ifdef _OPENMP
+#pragma omp parallel
+#pragma omp master
+#endif
+   {
+      _braid_RelaxSweep  *sweep;
+      braid_Int           s, b, blo, bhi, interval;
+
+      for (s = 0; s < nsweeps; s++)
+      {
+         sweep = &sweeps[s];
+         sweep->ustart = ustart;
+
+         _braid_Critical
          {
-            _braid_Step(core, level, fi, NULL, u);
-            _braid_USetVector(core, level, fi, u, 0);
+            _braid_UCommInit(core, level);
          }
 
-         /* C-relaxation */
-         if (ci > _braid_CoreElt(core, initiali))
+         /* Right-most intervals, which send to the right neighbor */
+#ifdef _OPENMP
+#pragma omp task if(0) depend(in: dep[nblocks]) depend(inout: dep[nblocks+1])
+#endif
          {
-            /* If weighted Jacobi, store the previous u-value,
-             *   Note, do no weighting if coarsest level*/
-            if( (CWt != 1.0) && (level != (nlevels-1)) )
+            for (interval = ncpoints; interval > thi; interval--)
             {
-               _braid_UGetVector(core, level, ci, &u_old);
+               _braid_FCRelaxInterval(core, level, interval, sweep);
             }
+         }
 
-            _braid_Step(core, level, ci, NULL, u);
-
-            if( (CWt != 1.0) && (level != (nlevels-1)) )
+         /* Blocks in between, from right to left */
+         for (b = nblocks-1; b > -1; b--)
+         {
+            _braid_ThreadBlock(tlo, thi, nblocks, b, &blo, &bhi);
+#ifdef _OPENMP
+#pragma omp task depend(in: dep[b], dep[b+1]) depend(out: sdep[b+1])
+#endif
             {
-               /* Apply weighted combination for w-Jacobi
-                * u <--  omega*u_new + (1-omega)*u_old */
-               _braid_BaseSum(core, app, (1.0 - CWt), u_old, CWt, u);
-               _braid_BaseFree(core, app, u_old);
+               /* Deferred tasks may run on any thread, and the call level is
+                * per thread */
+               _braid_SetCallLevel(level, NULL);
+               _braid_Critical
+               {
+                  _braid_FCRelaxStart(core, level, blo, sweep, &ustart[blo]);
+               }
             }
+#ifdef _OPENMP
+#pragma omp task depend(in: sdep[b+1]) depend(inout: dep[b+1])
+#endif
+            {
+               braid_Int  i;
 
-            _braid_USetVector(core, level, ci, u, 1);
+               _braid_SetCallLevel(level, NULL);
+               for (i = bhi; i >= blo; i--)
+               {
+                  _braid_FCRelaxInterval(core, level, i, sweep);
+               }
+            }
          }
 
-         /* if ((flo <= fhi) && (interval == ncpoints)) */
-         if ((flo <= fhi) && !(ci > _braid_CoreElt(core, initiali)))
+         /* Left-most interval, once the neighbor's point is here */
+         _braid_FCRelaxCommWait(core, level, 1);
+#ifdef _OPENMP
+#pragma omp task if(0) depend(inout: dep[0])
+#endif
          {
-            _braid_BaseFree(core, app,  u);
+            _braid_FCRelaxInterval(core, level, 0, sweep);
+         }
+
+         /* The next sweep reuses the message handles */
+         _braid_FCRelaxCommWait(core, level, 0);
+         _braid_Critical
+         {
+            _braid_UCommWait(core, level);
          }
       }
-      _braid_UCommWait(core, level);
    }
 
+   _braid_TFree(ustart);
+   _braid_TFree(sdep);
+   _braid_TFree(dep);
+
    return _braid_error_flag;
 }
 
+/*----------------------------------------------------------------------------
+ * Do one FC-sweep or C-sweep over the intervals of *level*
+ *----------------------------------------------------------------------------*/
+
+static braid_Int
+_braid_FCRelaxSweep(braid_Core          core,
+                    braid_Int           level,
+                    _braid_RelaxSweep  *sweep)
+{
+   _braid_Grid   **grids    = _braid_CoreElt(core, grids);
+   braid_Int       ncpoints = _braid_GridElt(grids[level], ncpoints);
+
+   braid_Int       interval;
+
+   _braid_UCommInit(core, level);
+
+   /* Start from the right-most interval, which computes the value sent to
+    * the right neighbor, and end with the interval that needs ua[-1] */
+   for (interval = ncpoints; interval > -1; interval--)
+   {
+      _braid_FCRelaxInterval(core, level, interval, sweep);
+
+      /* Only the left-most interval needs the neighbor's value, so keep
+       * the messages moving while the other intervals are computed */
+      if (interval > 0)
+      {
+         _braid_UCommProgress(core, level);
+      }
+   }
+   _braid_UCommWait(core, level);
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ * Do nu sweeps of F-then-C relaxation, or the sweeps of the relaxation
+ * schedule of *level* (see braid_SetRelaxSchedule).  The final F-relaxation
+ * is done by FRestrict (or FInterp).
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_FCRelax(braid_Core  core,
+               braid_Int   level)
+{
+   braid_App       app      = _braid_CoreElt(core, app);
+   braid_Int      *nrels    = _braid_CoreElt(core, nrels);
+   braid_Real     *CWts     = _braid_CoreElt(core, CWts);
+   braid_Int       nlevels  = _braid_CoreElt(core, nlevels);
+   _braid_Grid   **grids    = _braid_CoreElt(core, grids);
+   braid_Int       ncpoints = _braid_GridElt(grids[level], ncpoints);
+   const char     *rsched   = _braid_CoreElt(core, rscheds)[level];
+
+   _braid_RelaxSweep *sweeps;
+   braid_BaseVector  *fkeep = NULL;
+   const char        *p;
+   char              *end;
+   braid_Int          nsweeps, s, interval, fsweep, tlo, thi;
+
+   _braid_CoreElt(core, comm_phase) = _braid_PhaseRelax;
+   _braid_SetCallLevel(level, NULL);
+
+   if (rsched == NULL)
+   {
+      rsched = _braid_CoreElt(core, rsdefault);
+   }
+   if ( (rsched == NULL) || (level == (nlevels-1)) )
+   {
+      /* nu FC-sweeps */
+      nsweeps = nrels[level];
+      sweeps  = _braid_TAlloc(_braid_RelaxSweep, _braid_max(nsweeps, 1));
+      for (s = 0; s < nsweeps; s++)
+      {
+         sweeps[s].ustart = NULL;
+         sweeps[s].fkeep  = NULL;
+         sweeps[s].fsweep = 1;
+         sweeps[s].CWt    = CWts[level];
+      }
+   }
+   else
+   {
+      /* The sweeps of the schedule.  Each C makes an FC-sweep, except that a
+       * C right after another C makes a C-sweep.  Adjacent F-sweeps are fused,
+       * and a C at the start gets an F-sweep, because the F-points are not
+       * current after interpolation. */
+      sweeps  = _braid_TAlloc(_braid_RelaxSweep, _braid_max((braid_Int) strlen(rsched), 1));
+      nsweeps = 0;
+      fsweep  = 1;
+      for (p = rsched; *p != '\0'; )
+      {
+         if (*p == 'F')
+         {
+            fsweep = 1;
+            p++;
+            continue;
+         }
+
+         /* C with an optional weight */
+         sweeps[nsweeps].CWt = strtod(p+1, &end);
+         if (end == (p+1))
+         {
+            sweeps[nsweeps].CWt = CWts[level];
+         }
+         p = end;
+
+         /* Keep the last F-points only if a C-sweep needs them */
+         if ( (fkeep == NULL) && (*p == 'C') )
+         {
+            fkeep = _braid_CTAlloc(braid_BaseVector, ncpoints+1);
+         }
+         sweeps[nsweeps].ustart = NULL;
+         sweeps[nsweeps].fkeep  = (!fsweep || (*p == 'C')) ? fkeep : NULL;
+         sweeps[nsweeps].fsweep = fsweep;
+         nsweeps++;
+         fsweep = 0;
+      }
+   }
+
+   _braid_ThreadIntervals(core, level, &tlo, &thi);
+   if ( (tlo <= thi) && (nsweeps > 0) )
+   {
+      _braid_FCRelaxTasks(core, level, tlo, thi, sweeps, nsweeps);
+   }
+   else
+   {
+      for (s = 0; s < nsweeps; s++)
+      {
+         _braid_FCRelaxSweep(core, level, &sweeps[s]);
+      }
+   }
+
+   if (fkeep != NULL)
+   {
+      for (interval = 0; interval <= ncpoints; interval++)
+      {
+         if (fkeep[interval] != NULL)
+         {
+            _braid_BaseFree(core, app, fkeep[interval]);
+         }
+      }
+      _braid_TFree(fkeep);
+   }
+   _braid_TFree(sweeps);
+
+   return _braid_error_flag;
+}
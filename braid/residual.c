@@ -37,7 +37,8 @@ _braid_Residual(braid_Core        core,
    braid_Real       tol      = _braid_CoreElt(core, tol);
    braid_Int        iter     = _braid_CoreElt(core, niter);
    _braid_Grid    **grids    = _braid_CoreElt(core, grids);
-   braid_StepStatus status   = (braid_StepStatus)core;
+   _braid_StepStatus status_s;
+   braid_StepStatus  status  = &status_s;
    braid_Int        nrefine  = _braid_CoreElt(core, nrefine);
    braid_Int        gupper   = _braid_CoreElt(core, gupper);
    braid_Int        ilower   = _braid_GridElt(grids[level], ilower);
@@ -46,12 +47,17 @@ _braid_Residual(braid_Core        core,
    braid_BaseVector rstop;
    braid_Int        ii;
 
+   _braid_StatusInit(core, (braid_Status) status);
+
    ii = index-ilower;
    _braid_StepStatusInit(ta[ii-1], ta[ii], index-1, tol, iter, level, nrefine, gupper, status);
    if ( _braid_CoreElt(core, residual) == NULL )
    {
       /* By default: r = ustop - \Phi(ustart)*/
-      _braid_GetUInit(core, level, index, r, &rstop);
+      _braid_Critical
+      {
+         _braid_GetUInit(core, level, index, r, &rstop);
+      }
       _braid_BaseStep(core, app,  rstop, NULL, r, level, status);
       _braid_BaseSum(core, app,  1.0, ustop, -1.0, r);
    }
@@ -60,6 +66,10 @@ _braid_Residual(braid_Core        core,
       /* Call the user's residual routine */
       _braid_BaseResidual(core, app, ustop, r, status);
    }
+   _braid_Critical
+   {
+      _braid_StepStatusDone(status);
+   }
 
    return _braid_error_flag;
 }
@@ -22,6 +22,162 @@
 #include "_braid.h"
 #include "util.h"
 
+/*----------------------------------------------------------------------------
+ * F-then-C relaxation of one interval, and restriction of its C-point and
+ * residual to level+1 (see _braid_IntervalFcn).  On level 0, the spatial
+ * norm of the residual is stored in tnorm_a[interval].
+ *----------------------------------------------------------------------------*/
+
+static braid_Int
+_braid_FRestrictInterval(braid_Core  core,
+                         braid_Int   level,
+                         braid_Int   interval,
+                         void       *data)
+{
+   braid_App             app          = _braid_CoreElt(core, app);
+   _braid_Grid         **grids        = _braid_CoreElt(core, grids);
+   _braid_AccessStatus   astatus_s;
+   braid_AccessStatus    astatus      = &astatus_s;
+   _braid_ObjectiveStatus ostatus_s;
+   braid_ObjectiveStatus  ostatus     = &ostatus_s;
+   braid_Int             iter         = _braid_CoreElt(core, niter);
+   braid_Int             access_level = _braid_CoreElt(core, access_level);
+   braid_Real           *tnorm_a      = _braid_CoreElt(core, tnorm_a);
+   braid_Int             nrefine      = _braid_CoreElt(core, nrefine);
+   braid_Int             gupper       = _braid_CoreElt(core, gupper);
+   braid_Int             cfactor      = _braid_GridElt(grids[level], cfactor);
+   braid_Real           *ta           = _braid_GridElt(grids[level], ta);
+   braid_Int             f_ilower     = _braid_GridElt(grids[level], ilower);
+   braid_Int             c_level      = level+1;
+   braid_Int             c_ilower     = _braid_GridElt(grids[c_level], ilower);
+   braid_BaseVector     *c_va         = _braid_GridElt(grids[c_level], va);
+   braid_BaseVector     *c_fa         = _braid_GridElt(grids[c_level], fa);
+
+   braid_BaseVector     u, r, ustop;
+   braid_Int            flo, fhi, fi, ci, c_index;
+   braid_Real           rnm;
+
+   _braid_StatusInit(core, (braid_Status) astatus);
+   _braid_StatusInit(core, (braid_Status) ostatus);
+
+   _braid_GetInterval(core, level, interval, &flo, &fhi, &ci);
+
+   _braid_Critical
+   {
+      if (flo <= fhi)
+      {
+         _braid_UGetVector(core, level, flo-1, &r);
+      }
+      else if (ci > _braid_CoreElt(core, initiali))
+      {
+         _braid_UGetVector(core, level, ci-1, &r);
+      }
+   }
+
+   /* F-relaxation */
+   _braid_GetRNorm(core, -1, &rnm);
+   for (fi = flo; fi <= fhi; fi++)
+   {
+      _braid_Critical
+      {
+         _braid_GetUInit(core, level, fi, r, &ustop);
+      }
+      _braid_Step(core, level, fi, ustop, r);
+      _braid_Critical
+      {
+         _braid_USetVector(core, level, fi, r, 0);
+
+         /* Allow user to process current vector, note that r here is
+          * temporarily holding the state vector */
+         if( (access_level >= 3) )
+         {
+            _braid_AccessStatusInit(ta[fi-f_ilower], fi, rnm, iter, level, nrefine, gupper,
+                                    0, 0, braid_ASCaller_FRestrict, astatus);
+            _braid_AccessVector(core, astatus, r);
+         }
+      }
+
+      /* Evaluate the user's local objective function at F-points on finest grid */
+      if ( _braid_CoreElt(core, adjoint) && level == 0)
+      {
+         _braid_ObjectiveStatusInit(ta[fi-f_ilower], fi, iter, level, nrefine, gupper, ostatus);
+         _braid_AddToObjective(core, r, ostatus);
+      }
+
+   }
+
+   _braid_Critical
+   {
+      /* Allow user to process current C-point */
+      if( (access_level>= 3) && (ci > -1) )
+      {
+         _braid_AccessStatusInit(ta[ci-f_ilower], ci, rnm, iter, level, nrefine, gupper,
+                                 0, 0, braid_ASCaller_FRestrict, astatus);
+         _braid_UGetVectorRef(core, level, ci, &u);
+         _braid_AccessVector(core, astatus, u);
+      }
+
+      /* Evaluate the user's local objective function at CPoints on finest grid */
+      if (_braid_CoreElt(core, adjoint) && level == 0 && (ci > -1) )
+      {
+         _braid_ObjectiveStatusInit(ta[ci-f_ilower], ci, iter, level, nrefine, gupper, ostatus);
+         _braid_UGetVectorRef(core, 0, ci, &u);
+         _braid_AddToObjective(core, u, ostatus);
+      }
+
+      if (ci > _braid_CoreElt(core, initiali))
+      {
+         _braid_UGetVectorRef(core, level, ci, &u);
+      }
+   }
+
+   /* Compute residual and restrict */
+   if (ci > _braid_CoreElt(core, initiali))
+   {
+      /* Compute FAS residual */
+      _braid_FASResidual(core, level, ci, u, r);
+
+      /* Compute rnorm (only on level 0) */
+      if (level == 0)
+      {
+         _braid_BaseSpatialNorm(core, app,  r, &tnorm_a[interval]);
+      }
+
+      /* Restrict u and residual, coarsening in space if needed */
+      _braid_MapFineToCoarse(ci, cfactor, c_index);
+      _braid_Critical
+      {
+         _braid_Coarsen(core, c_level, ci, c_index, u, &c_va[c_index-c_ilower]);
+         _braid_Coarsen(core, c_level, ci, c_index, r, &c_fa[c_index-c_ilower]);
+      }
+   }
+   else if (ci == 0)
+   {
+      /* Restrict initial condition, coarsening in space if needed */
+      _braid_Critical
+      {
+         _braid_UGetVectorRef(core, level, 0, &u);
+         _braid_Coarsen(core, c_level, 0, 0, u, &c_va[0]);
+      }
+   }
+
+   _braid_Critical
+   {
+      if ((flo <= fhi) || (ci > _braid_CoreElt(core, initiali)))
+      {
+         _braid_BaseFree(core, app,  r);
+      }
+
+      /* Pack the C-point used above again (if stored packed) */
+      if (ci > -1)
+      {
+         _braid_URepack(core, level, ci, ci);
+      }
+   }
+
+   return _braid_error_flag;
+}
+
 /*----------------------------------------------------------------------------
  * F-Relax on level and restrict to level+1
  *
@@ -70,28 +226,20 @@ _braid_FRestrict(braid_Core   core,
    MPI_Comm              comm         = _braid_CoreElt(core, comm);
    braid_App             app          = _braid_CoreElt(core, app);
    _braid_Grid         **grids        = _braid_CoreElt(core, grids);
-   braid_AccessStatus    astatus      = (braid_AccessStatus)core;
-   braid_ObjectiveStatus ostatus      = (braid_ObjectiveStatus)core;
-   braid_Int             iter         = _braid_CoreElt(core, niter);
    braid_Int             print_level  = _braid_CoreElt(core, print_level);
-   braid_Int             access_level = _braid_CoreElt(core, access_level);
    braid_Int             tnorm        = _braid_CoreElt(core, tnorm);
    braid_Real           *tnorm_a      = _braid_CoreElt(core, tnorm_a);
-   braid_Int             nrefine      = _braid_CoreElt(core, nrefine);
-   braid_Int             gupper       = _braid_CoreElt(core, gupper);
-   braid_Int             cfactor      = _braid_GridElt(grids[level], cfactor);
    braid_Int             ncpoints     = _braid_GridElt(grids[level], ncpoints);
-   braid_Real           *ta           = _braid_GridElt(grids[level], ta);
-   braid_Int             f_ilower     = _braid_GridElt(grids[level], ilower);
    _braid_CommHandle    *recv_handle  = NULL;
    _braid_CommHandle    *send_handle  = NULL;
+   braid_Int             recv_agg     = 0;
+   braid_Int             send_agg     = 0;
 
-   braid_Int            c_level, c_ilower, c_iupper, c_index, c_i, c_ii;
+   braid_Int            c_level, c_ilower, c_iupper, c_i, c_ii;
    braid_BaseVector     c_u, *c_va, *c_fa;
 
-   braid_BaseVector     u, r;
-   braid_Int            interval, flo, fhi, fi, ci;
-   braid_Real           rnorm, grnorm, rnorm_temp, rnm;
+   braid_Int            interval, flo, fhi, ci, tlo, thi;
+   braid_Real           rnorm, grnorm;
 
    c_level  = level+1;
    c_ilower = _braid_GridElt(grids[c_level], ilower);
@@ -101,7 +249,35 @@ _braid_FRestrict(braid_Core   core,
 
    rnorm = 0.0;
 
-   _braid_UCommInit(core, level);
+   _braid_CoreElt(core, comm_phase) = _braid_PhaseRestrict;
+   _braid_SetCallLevel(level, NULL);
+   _braid_ThreadIntervals(core, level, &tlo, &thi);
+
+   /* The c_va[-1] boundary update usually goes to the same neighbor as the
+    * exchange on this level, so send both vectors in one message (unless the
+    * neighbor is reached through shared memory) */
+   if ( _braid_CoreElt(core, comm_agg) && !_braid_CoreElt(core, adjoint) &&
+        !_braid_CoreElt(core, periodic) && (c_ilower <= c_iupper) &&
+        (_braid_GridElt(grids[level], ilower) <= _braid_GridElt(grids[level], iupper)) )
+   {
+      recv_agg = ( (_braid_GridElt(grids[level], left_proc) > -1) &&
+                   (_braid_GridElt(grids[level], shm_recv) == NULL) &&
+                   (_braid_GridElt(grids[level], left_proc) ==
+                    _braid_GridElt(grids[c_level], left_proc)) );
+      send_agg = ( (_braid_GridElt(grids[level], right_proc) > -1) &&
+                   (_braid_GridElt(grids[level], shm_send) == NULL) &&
+                   (_braid_GridElt(grids[level], right_proc) ==
+                    _braid_GridElt(grids[c_level], right_proc)) );
+   }
+
+   if (recv_agg || send_agg)
+   {
+      _braid_UCommInitAgg(core, level, recv_agg, send_agg, &c_va[-1]);
+   }
+   else
+   {
+      _braid_UCommInit(core, level);
+   }
 
    /* Start from the right-most interval.
     * 
@@ -110,97 +286,21 @@ _braid_FRestrict(braid_Core   core,
     * convergence checking on the finest grid.  This loop updates va and fa. */
    for (interval = ncpoints; interval > -1; interval--)
    {
-      _braid_GetInterval(core, level, interval, &flo, &fhi, &ci);
-
-      if (flo <= fhi)
-      {
-         _braid_UGetVector(core, level, flo-1, &r);
-      }
-      else if (ci > _braid_CoreElt(core, initiali))
+      if (interval == thi)
       {
-         _braid_UGetVector(core, level, ci-1, &r);
+         /* Do the intervals in between with threads */
+         _braid_ThreadLoop(core, level, tlo, thi, _braid_FRestrictInterval, NULL);
+         interval = tlo;
+         continue;
       }
+      _braid_FRestrictInterval(core, level, interval, NULL);
 
-      /* F-relaxation */
-      _braid_GetRNorm(core, -1, &rnm);
-      for (fi = flo; fi <= fhi; fi++)
-      {
-         _braid_Step(core, level, fi, NULL, r);
-         _braid_USetVector(core, level, fi, r, 0);
-         
-         /* Allow user to process current vector, note that r here is
-          * temporarily holding the state vector */
-         if( (access_level >= 3) )
-         {
-            _braid_AccessStatusInit(ta[fi-f_ilower], fi, rnm, iter, level, nrefine, gupper,
-                                    0, 0, braid_ASCaller_FRestrict, astatus);
-            _braid_AccessVector(core, astatus, r);
-         }
-
-         /* Evaluate the user's local objective function at F-points on finest grid */
-         if ( _braid_CoreElt(core, adjoint) && level == 0)
-         {
-            _braid_ObjectiveStatusInit(ta[fi-f_ilower], fi, iter, level, nrefine, gupper, ostatus);
-            _braid_AddToObjective(core, r, ostatus);
-         }
-
-      }
-
-      /* Allow user to process current C-point */
-      if( (access_level>= 3) && (ci > -1) )
-      {
-         _braid_AccessStatusInit(ta[ci-f_ilower], ci, rnm, iter, level, nrefine, gupper,
-                                 0, 0, braid_ASCaller_FRestrict, astatus);
-         _braid_UGetVectorRef(core, level, ci, &u);
-         _braid_AccessVector(core, astatus, u);
-      }
-
-      /* Evaluate the user's local objective function at CPoints on finest grid */
-      if (_braid_CoreElt(core, adjoint) && level == 0 && (ci > -1) )
-      {
-         _braid_ObjectiveStatusInit(ta[ci-f_ilower], ci, iter, level, nrefine, gupper, ostatus);
-         _braid_UGetVectorRef(core, 0, ci, &u);
-         _braid_AddToObjective(core, u, ostatus);
-      }
-         
-      
-      /* Compute residual and restrict */
-      if (ci > _braid_CoreElt(core, initiali))
-      {
-         /* Compute FAS residual */
-         _braid_UGetVectorRef(core, level, ci, &u);
-         _braid_FASResidual(core, level, ci, u, r);
-
-         /* Compute rnorm (only on level 0) */
-         if (level == 0)
-         {
-            _braid_BaseSpatialNorm(core, app,  r, &rnorm_temp);
-            tnorm_a[interval] = rnorm_temp;       /* inf-norm uses tnorm_a */
-            if(tnorm == 1) 
-            {  
-               rnorm += rnorm_temp;               /* one-norm combination */ 
-            }
-            else if(tnorm == 2)
-            {  
-               rnorm += (rnorm_temp*rnorm_temp);  /* two-norm combination */
-            }
-         }
-
-         /* Restrict u and residual, coarsening in space if needed */
-         _braid_MapFineToCoarse(ci, cfactor, c_index);
-         _braid_Coarsen(core, c_level, ci, c_index, u, &c_va[c_index-c_ilower]);
-         _braid_Coarsen(core, c_level, ci, c_index, r, &c_fa[c_index-c_ilower]);
-      }
-      else if (ci == 0)
-      {
-         /* Restrict initial condition, coarsening in space if needed */
-         _braid_UGetVectorRef(core, level, 0, &u);
-         _braid_Coarsen(core, c_level, 0, 0, u, &c_va[0]);
-      }
-
-      if ((flo <= fhi) || (ci > _braid_CoreElt(core, initiali)))
+      /* Complete the aggregated send with the coarse-grid boundary value */
+      _braid_GetInterval(core, level, interval, &flo, &fhi, &ci);
+      if ( send_agg && (ci == _braid_GridElt(grids[level], cupper)) )
       {
-         _braid_BaseFree(core, app,  r);
+         _braid_CommSendAppend(core, _braid_GridElt(grids[level], send_handle), 1,
+                               c_va[c_iupper-c_ilower]);
       }
    }
    _braid_UCommWait(core, level);
@@ -215,6 +315,23 @@ _braid_FRestrict(braid_Core   core,
    /* Compute rnorm (only on level 0) */
    if (level == 0)
    {
+      /* Combine the interval norms, in the order of the loop above */
+      for (interval = ncpoints; interval > -1; interval--)
+      {
+         _braid_GetInterval(core, level, interval, &flo, &fhi, &ci);
+         if (ci > _braid_CoreElt(core, initiali))
+         {
+            if(tnorm == 1) 
+            {  
+               rnorm += tnorm_a[interval];                      /* one-norm combination */ 
+            }
+            else if(tnorm == 2)
+            {  
+               rnorm += (tnorm_a[interval]*tnorm_a[interval]);  /* two-norm combination */
+            }
+         }
+      }
+
       if(tnorm == 1)          /* one-norm reduction */
       {  
          MPI_Allreduce(&rnorm, &grnorm, 1, braid_MPI_REAL, MPI_SUM, comm);
@@ -234,7 +351,9 @@ _braid_FRestrict(braid_Core   core,
       _braid_SetRNorm(core, -1, grnorm);
    }
    
-   /* Now apply coarse residual to update fa values */
+   /* Now apply coarse residual to update fa values, charging the calls to the
+    * coarse level */
+   _braid_SetCallLevel(c_level, NULL);
 
    /* Set initial guess on coarse level */
    _braid_InitGuess(core, c_level);
@@ -242,8 +361,14 @@ _braid_FRestrict(braid_Core   core,
    /* Initialize update of c_va[-1] boundary */
    if (c_ilower <= c_iupper)
    {
-      _braid_CommRecvInit(core, c_level, c_ilower-1, &c_va[-1], &recv_handle);
-      _braid_CommSendInit(core, c_level, c_iupper, c_va[c_iupper-c_ilower], &send_handle);
+      if (!recv_agg)
+      {
+         _braid_CommRecvInit(core, c_level, c_ilower-1, &c_va[-1], &recv_handle);
+      }
+      if (!send_agg)
+      {
+         _braid_CommSendInit(core, c_level, c_iupper, c_va[c_iupper-c_ilower], &send_handle);
+      }
    }
 
    /* Start with rightmost point */
@@ -257,13 +382,14 @@ _braid_FRestrict(braid_Core   core,
             /* Finalize update of c_va[-1] */
             _braid_CommWait(core, &recv_handle);
          }
-         _braid_BaseClone(core, app,  c_va[c_ii-1], &c_u);
+         _braid_GridScratch(core, grids[c_level], c_va[c_ii-1], &c_u);
          _braid_Residual(core, c_level, c_i, c_va[c_ii], c_u);
          _braid_BaseSum(core, app,  1.0, c_u, 1.0, c_fa[c_ii]);
-         _braid_BaseFree(core, app,  c_u);
+         _braid_GridScratchFree(core, grids[c_level], c_u);
       }
    }
    _braid_CommWait(core, &send_handle);
+   _braid_SetCallLevel(level, NULL);
   
    return _braid_error_flag;
 }
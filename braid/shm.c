@@ -0,0 +1,368 @@
+/*BHEADER**********************************************************************
+ * Copyright (c) 2013, Lawrence Livermore National Security, LLC.
+ * Produced at the Lawrence Livermore National Laboratory.
+ *
+ * This file is part of XBraid. For support, post issues to the XBraid Github page.
+ *
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License (as published by the Free Software
+ * Foundation) version 2.1 dated February 1999.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the IMPLIED WARRANTY OF MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE. See the terms and conditions of the GNU General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc., 59
+ * Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+ ***********************************************************************EHEADER*/
+
+/** \file shm.c
+ * \brief Source code for the shared-memory transport between temporal
+ * neighbors on the same node.  See braid_SetShmComm() for more information.
+ *
+ * Each processor owns _braid_ShmNBuffers message slots per level and
+ * communication phase in an MPI shared-memory window, which are written by its
+ * left neighbor.  Phases have their own slots, just as they have their own
+ * message tags (see _braid_CommTag).  Within a phase, sends and receives take
+ * the slots in turn, so messages arrive in order and a sender can run ahead of
+ * its receiver by one message less than the number of slots.  A slot holds a
+ * small header (a full/empty flag, the size and the sender rank) followed by
+ * the packed vector.  The sender packs straight into the receiver's slot and
+ * raises the flag, and the receiver unpacks and clears it.  The window is
+ * passively locked for its lifetime and MPI_Win_sync orders the data and flag
+ * accesses.
+ */
+
+#include <string.h>
+#include "_braid.h"
+#include "util.h"
+
+#if _braid_SHMEM
+#include <sched.h>
+#endif
+
+/* Slot header, padded so the packed data stays aligned */
+typedef struct
+{
+   volatile braid_Int  flag;    /* 1 if the slot holds a message, 0 if it is free */
+   braid_Int           size;    /* size in bytes of the packed data */
+   braid_Int           source;  /* rank of the sender in the temporal communicator */
+} _braid_ShmHeader;
+
+#define _braid_ShmHeaderSize  (2*sizeof(braid_Real))
+#define _braid_ShmSlotData(slot)  ((char *) (slot) + _braid_ShmHeaderSize)
+
+/* Number of polls of a slot flag before a waiting processor starts yielding */
+#define _braid_ShmSpins  64
+
+/*----------------------------------------------------------------------------
+ * Wait for a slot flag to reach a value.  After a short spin, each poll also
+ * lets MPI progress other messages and yields the core, since the neighbor
+ * may be sharing it (e.g., when oversubscribed).
+ *----------------------------------------------------------------------------*/
+
+#if _braid_SHMEM
+static braid_Int
+_braid_ShmWait(braid_Core         core,
+               _braid_ShmHeader  *header,
+               braid_Int          flag)
+{
+   MPI_Win    win   = _braid_CoreElt(core, shm_win);
+   braid_Int  spins = 0;
+   int        pending;
+
+   MPI_Win_sync(win);
+   while (header->flag != flag)
+   {
+      if (spins < _braid_ShmSpins)
+      {
+         spins++;
+      }
+      else
+      {
+         MPI_Iprobe(MPI_ANY_SOURCE, MPI_ANY_TAG, _braid_CoreElt(core, comm),
+                    &pending, MPI_STATUS_IGNORE);
+         sched_yield();
+      }
+      MPI_Win_sync(win);
+   }
+
+   return _braid_error_flag;
+}
+#endif
+
+/*----------------------------------------------------------------------------
+ * Release the shared window of the previous hierarchy (if any)
+ *----------------------------------------------------------------------------*/
+
+static braid_Int
+_braid_ShmFree(braid_Core  core)
+{
+#if _braid_SHMEM
+   if (_braid_CoreElt(core, shm_slot_size) > 0)
+   {
+      MPI_Win_unlock_all(_braid_CoreElt(core, shm_win));
+      MPI_Win_free(&_braid_CoreElt(core, shm_win));
+      _braid_CoreElt(core, shm_slot_size) = 0;
+   }
+#endif
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_ShmInit(braid_Core  core)
+{
+#if _braid_SHMEM
+   MPI_Comm            comm     = _braid_CoreElt(core, comm);
+   braid_App           app      = _braid_CoreElt(core, app);
+   _braid_Grid       **grids    = _braid_CoreElt(core, grids);
+   braid_Int           nlevels  = _braid_CoreElt(core, nlevels);
+   _braid_BufferStatus bstatus_s;
+   braid_BufferStatus  bstatus  = &bstatus_s;
+   MPI_Comm            shm_comm;
+   MPI_Group           group, shm_group;
+   MPI_Aint            win_size;
+   char               *base;
+   int                 disp_unit, shm_nprocs;
+   int                 procs[2], shm_procs[2];
+   braid_Int           level, phase, size, slot_size, level_size;
+
+   _braid_StatusInit(core, (braid_Status) bstatus);
+
+   _braid_ShmFree(core);
+
+   /* Message slots are only safe for the one-directional neighbor exchange */
+   if ( !_braid_CoreElt(core, shm) || _braid_CoreElt(core, adjoint) ||
+        _braid_CoreElt(core, periodic) || (_braid_CoreElt(core, nprocs) == 1) )
+   {
+      return _braid_error_flag;
+   }
+
+   /* Group the processors of the temporal communicator by node */
+   shm_comm = _braid_CoreElt(core, shm_comm);
+   if (shm_comm == MPI_COMM_NULL)
+   {
+      MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, _braid_CoreElt(core, myid),
+                          MPI_INFO_NULL, &shm_comm);
+      _braid_CoreElt(core, shm_comm) = shm_comm;
+   }
+   MPI_Comm_size(shm_comm, &shm_nprocs);
+   if (shm_nprocs == 1)
+   {
+      return _braid_error_flag;
+   }
+
+   /* Slots are large enough for a full BufSize message */
+   _braid_BufferStatusInit( 0, 0, bstatus );
+   _braid_BaseBufSize(core, app,  &size, bstatus);
+   slot_size = _braid_ShmHeaderSize +
+      ((size + sizeof(braid_Real) - 1) / sizeof(braid_Real)) * sizeof(braid_Real);
+   level_size = _braid_NPhases*_braid_ShmNBuffers*slot_size;
+
+   win_size = (MPI_Aint) nlevels * level_size;
+   MPI_Win_allocate_shared(win_size, 1, MPI_INFO_NULL, shm_comm, &base,
+                           &_braid_CoreElt(core, shm_win));
+   memset(base, 0, win_size);
+   MPI_Win_lock_all(MPI_MODE_NOCHECK, _braid_CoreElt(core, shm_win));
+   MPI_Win_sync(_braid_CoreElt(core, shm_win));
+   MPI_Barrier(shm_comm);
+   _braid_CoreElt(core, shm_slot_size) = slot_size;
+
+   /* Find the slots of the neighbors that live on this node */
+   MPI_Comm_group(comm, &group);
+   MPI_Comm_group(shm_comm, &shm_group);
+   for (level = 0; level < nlevels; level++)
+   {
+      _braid_GetProc(core, level, _braid_GridElt(grids[level], ilower)-1, &procs[0]);
+      _braid_GetProc(core, level, _braid_GridElt(grids[level], iupper)+1, &procs[1]);
+      shm_procs[0] = shm_procs[1] = MPI_UNDEFINED;
+      if (procs[0] > -1)
+      {
+         MPI_Group_translate_ranks(group, 1, &procs[0], shm_group, &shm_procs[0]);
+      }
+      if (procs[1] > -1)
+      {
+         MPI_Group_translate_ranks(group, 1, &procs[1], shm_group, &shm_procs[1]);
+      }
+
+      _braid_GridElt(grids[level], shm_recv) = NULL;
+      _braid_GridElt(grids[level], shm_send) = NULL;
+      for (phase = 0; phase < _braid_NPhases; phase++)
+      {
+         _braid_GridElt(grids[level], shm_nrecv)[phase] = 0;
+         _braid_GridElt(grids[level], shm_nsend)[phase] = 0;
+      }
+      if (shm_procs[0] != MPI_UNDEFINED)
+      {
+         _braid_GridElt(grids[level], shm_recv) = base + level*level_size;
+      }
+      if (shm_procs[1] != MPI_UNDEFINED)
+      {
+         MPI_Win_shared_query(_braid_CoreElt(core, shm_win), shm_procs[1],
+                              &win_size, &disp_unit, &_braid_GridElt(grids[level], shm_send));
+         _braid_GridElt(grids[level], shm_send) =
+            (char *) _braid_GridElt(grids[level], shm_send) + level*level_size;
+      }
+   }
+   MPI_Group_free(&group);
+   MPI_Group_free(&shm_group);
+#endif
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_ShmDestroy(braid_Core  core)
+{
+   _braid_ShmFree(core);
+   if (_braid_CoreElt(core, shm_comm) != MPI_COMM_NULL)
+   {
+      MPI_Comm_free(&_braid_CoreElt(core, shm_comm));
+   }
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_ShmFits(braid_Core   core,
+               braid_Int    size,
+               braid_Int   *fits_ptr)
+{
+   *fits_ptr = (_braid_ShmHeaderSize + size <= _braid_CoreElt(core, shm_slot_size));
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ * Take the next slot of the current phase on this level, for a receive from
+ * the left neighbor (recv = 1) or a send to the right neighbor (recv = 0)
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_ShmNextSlot(braid_Core   core,
+                   braid_Int    level,
+                   braid_Int    recv,
+                   void       **slot_ptr)
+{
+   _braid_Grid  *grid  = _braid_CoreElt(core, grids)[level];
+   braid_Int     phase = _braid_CoreElt(core, comm_phase);
+   braid_Int    *count;
+   char         *base;
+
+   if (recv)
+   {
+      base  = (char *) _braid_GridElt(grid, shm_recv);
+      count = &_braid_GridElt(grid, shm_nrecv)[phase];
+   }
+   else
+   {
+      base  = (char *) _braid_GridElt(grid, shm_send);
+      count = &_braid_GridElt(grid, shm_nsend)[phase];
+   }
+
+   *slot_ptr = base + (phase*_braid_ShmNBuffers + (*count)%_braid_ShmNBuffers) *
+      _braid_CoreElt(core, shm_slot_size);
+   (*count)++;
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_ShmSend(braid_Core        core,
+               void             *slot,
+               braid_Int         proc,
+               braid_BaseVector  vector)
+{
+#if _braid_SHMEM
+   braid_App           app     = _braid_CoreElt(core, app);
+   MPI_Win             win     = _braid_CoreElt(core, shm_win);
+   _braid_ShmHeader   *header  = (_braid_ShmHeader *) slot;
+   _braid_BufferStatus bstatus_s;
+   braid_BufferStatus  bstatus = &bstatus_s;
+
+   _braid_StatusInit(core, (braid_Status) bstatus);
+
+   /* Wait for the receiver to consume the last message in this slot */
+   _braid_ShmWait(core, header, 0);
+
+   _braid_BufferStatusInit( 0, 0, bstatus );
+   _braid_StatusElt(bstatus, send_recv_rank) = proc;
+   _braid_StatusElt(bstatus, size_buffer)    = _braid_CoreElt(core, shm_slot_size) - _braid_ShmHeaderSize;
+   _braid_BaseBufPack(core, app,  vector, _braid_ShmSlotData(slot), bstatus);
+   header->size   = _braid_StatusElt(bstatus, size_buffer);
+   header->source = _braid_CoreElt(core, myid);
+
+   /* Make the data visible before raising the flag */
+   MPI_Win_sync(win);
+   header->flag = 1;
+   MPI_Win_sync(win);
+#endif
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_ShmTest(braid_Core   core,
+               void        *slot,
+               braid_Int   *flag_ptr)
+{
+#if _braid_SHMEM
+   MPI_Win_sync(_braid_CoreElt(core, shm_win));
+   *flag_ptr = ((_braid_ShmHeader *) slot)->flag;
+#else
+   *flag_ptr = 1;
+#endif
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_ShmRecv(braid_Core         core,
+               void              *slot,
+               braid_BaseVector  *vector_ptr)
+{
+#if _braid_SHMEM
+   braid_App           app     = _braid_CoreElt(core, app);
+   MPI_Win             win     = _braid_CoreElt(core, shm_win);
+   _braid_ShmHeader   *header  = (_braid_ShmHeader *) slot;
+   _braid_BufferStatus bstatus_s;
+   braid_BufferStatus  bstatus = &bstatus_s;
+
+   _braid_StatusInit(core, (braid_Status) bstatus);
+
+   _braid_ShmWait(core, header, 1);
+
+   _braid_BufferStatusInit( 0, 0, bstatus );
+   _braid_StatusElt(bstatus, send_recv_rank) = header->source;
+   _braid_BaseBufUnpack(core, app,  _braid_ShmSlotData(slot), vector_ptr, bstatus);
+
+   /* Free the slot for the next message once the data has been read */
+   MPI_Win_sync(win);
+   header->flag = 0;
+   MPI_Win_sync(win);
+#endif
+
+   return _braid_error_flag;
+}
@@ -36,7 +36,8 @@ _braid_Coarsen(braid_Core        core,
 {
    braid_App      app             = _braid_CoreElt(core, app);
    _braid_Grid  **grids           = _braid_CoreElt(core, grids);
-   braid_CoarsenRefStatus cstatus = (braid_CoarsenRefStatus)core;
+   _braid_CoarsenRefStatus cstatus_s;
+   braid_CoarsenRefStatus  cstatus = &cstatus_s;
    braid_Int      nrefine         = _braid_CoreElt(core, nrefine);
    braid_Int      gupper          = _braid_CoreElt(core, gupper);
    braid_Int      c_ilower        = _braid_GridElt(grids[level], ilower);
@@ -46,7 +47,12 @@ _braid_Coarsen(braid_Core        core,
 
    braid_Int      c_ii = c_index-c_ilower;
    braid_Int      f_ii = f_index-f_ilower;
-   
+   braid_Int      call_level;
+
+   _braid_StatusInit(core, (braid_Status) cstatus);
+
+   /* The coarse vector is charged to the coarse level */
+   _braid_SetCallLevel(level, &call_level);
    if ( _braid_CoreElt(core, scoarsen) == NULL )
    {
       /* No spatial coarsening needed, just clone the fine vector.*/
@@ -60,6 +66,8 @@ _braid_Coarsen(braid_Core        core,
                                   level-1, nrefine, gupper, c_index, cstatus);
       _braid_BaseSCoarsen(core, app, fvector, cvector, cstatus);
    }
+   _braid_SetCallLevel(call_level, NULL);
+
    return _braid_error_flag;
 }
 
@@ -77,10 +85,16 @@ _braid_RefineBasic(braid_Core        core,
                    braid_BaseVector *fvector)
 {
    braid_App              app     = _braid_CoreElt(core, app);
-   braid_CoarsenRefStatus cstatus = (braid_CoarsenRefStatus)core;
+   _braid_CoarsenRefStatus cstatus_s;
+   braid_CoarsenRefStatus  cstatus = &cstatus_s;
    braid_Int              nrefine = _braid_CoreElt(core, nrefine);
    braid_Int              gupper  = _braid_CoreElt(core, gupper);
+   braid_Int              call_level;
+
+   _braid_StatusInit(core, (braid_Status) cstatus);
 
+   /* The fine vector is charged to the fine level */
+   _braid_SetCallLevel(level, &call_level);
    if ( _braid_CoreElt(core, scoarsen) == NULL )
    {
       /* No spatial refinement needed, just clone the fine vector.*/
@@ -93,6 +107,7 @@ _braid_RefineBasic(braid_Core        core,
                                   level, nrefine, gupper, c_index, cstatus);
       _braid_BaseSRefine(core,  app, cvector, fvector, cstatus);
    }
+   _braid_SetCallLevel(call_level, NULL);
 
    return _braid_error_flag;
 }
@@ -35,15 +35,46 @@ extern "C" {
 #endif
 
 /*--------------------------------------------------------------------------
- * Define base Status structure as a pointer to core, and all other derived
- * Status structures as pointers to the base class.  
+ * Define base Status structure, and all other derived Status structures as
+ * wrappers of the base class.  A Status is a small value structure that is
+ * filled in by the calling XBraid routine right before each user call.  It
+ * points to the core for solver-wide data (grids, residual history, ...), but
+ * never writes to it, so several user calls can be in flight at once.
  *
  * See braid_status.h for a description of each Status structure.
  *--------------------------------------------------------------------------*/
 
 struct _braid_Status_struct
 {
-   _braid_Core core;
+   braid_Core    core;             /**< solver-wide data (grids, rnorms, nlevels, ...) */
+
+   /** Common Status properties */
+   braid_Real    t;                /**< current time */
+   braid_Int     idx;              /**< time point index value corresponding to t on the global time grid */
+   braid_Int     niter;            /**< current iteration in XBraid */
+   braid_Int     level;            /**< current level in XBraid*/
+   braid_Int     nrefine;          /**< number of refinements done */
+   braid_Int     gupper;           /**< global size of the fine grid */
+   /** AccessStatus properties */
+   braid_Real    rnorm;            /**< residual norm */
+   braid_Int     done;             /**< boolean describing whether XBraid has finished */
+   braid_Int     wrapper_test;     /**< boolean describing whether this call is only a wrapper test */
+   braid_Int     calling_function; /**< from which function are we accessing the vector */
+   /** CoarsenRefStatus properties*/
+   braid_Real    f_tprior;         /**< time value to the left of tstart on fine grid */
+   braid_Real    f_tstop;          /**< time value to the right of tstart  on fine grid */
+   braid_Real    c_tprior;         /**< time value to the left of tstart on coarse grid */
+   braid_Real    c_tstop;          /**< time value to the right of tstart on coarse grid */
+   /** StepStatus properties */
+   braid_Real    tnext;            /**< time value to evolve towards, time value to the right of tstart */
+   braid_Real    tol;              /**< current XBraid stopping tolerance */
+   braid_Real    old_fine_tolx;    /**< previously used fine tolerance, copied back to the core after the call */
+   braid_Int     tight_fine_tolx;  /**< boolean, tightest fine tolx has been used, copied back to the core */
+   braid_Int     r_space;          /**< spatial refinement flag, copied back to the core */
+   /** BufferStatus properties */
+   braid_Int     messagetype;      /**< message type, 0: for Step(), 1: for load balancing */
+   braid_Int     size_buffer;      /**< if set by user, send buffer will be "size" bytes in length */
+   braid_Int     send_recv_rank;   /**< holds the rank of the source / receiver from MPI_Send / MPI_Recv calls. */
 };
 typedef struct _braid_Status_struct _braid_Status;
 
@@ -51,41 +82,61 @@ struct _braid_AccessStatus_struct
 {
    _braid_Status status;
 };
+typedef struct _braid_AccessStatus_struct _braid_AccessStatus;
 
 struct _braid_SyncStatus_struct
 {
    _braid_Status status;
 };
+typedef struct _braid_SyncStatus_struct _braid_SyncStatus;
 
 struct _braid_StepStatus_struct
 {
    _braid_Status status;
 };
+typedef struct _braid_StepStatus_struct _braid_StepStatus;
 
 struct _braid_CoarsenRefStatus_struct
 {
    _braid_Status status;
 };
+typedef struct _braid_CoarsenRefStatus_struct _braid_CoarsenRefStatus;
 
 struct _braid_BufferStatus_struct
 {
    _braid_Status status;
 };
+typedef struct _braid_BufferStatus_struct _braid_BufferStatus;
 
 struct _braid_ObjectiveStatus_struct
 {
    _braid_Status status;
 };
+typedef struct _braid_ObjectiveStatus_struct _braid_ObjectiveStatus;
 
 /*--------------------------------------------------------------------------
  * Begin headers for internal Braid Status functions, like Destroy, and StatusInit
  *--------------------------------------------------------------------------*/
 
-#define _braid_StatusElt(status, elt) ( ((braid_Core)status) -> elt )
+#define _braid_StatusElt(status, elt) ( ((braid_Status)(status)) -> elt )
+
+/**
+ * Accessor for the core attributes behind a status structure
+ **/
+#define _braid_StatusCoreElt(status, elt) _braid_CoreElt(_braid_StatusElt(status, core), elt)
 
 braid_Int
 _braid_StatusDestroy(braid_Status status);
 
+/**
+ * Clear a status structure of any type and point it to the core.  This is
+ * done once for each status object, before the type specific Init routine.
+ */
+braid_Int
+_braid_StatusInit(braid_Core    core,      /**< braid_Core (_braid_Core) struct*/
+                  braid_Status  status     /**< structure to initialize */
+                  );
+
 /**
  * Initialize a braid_AccessStatus structure
  */
@@ -147,6 +198,15 @@ _braid_StepStatusInit(braid_Real        tstart,      /**< current time value  */
                       braid_StepStatus  status       /**< structure to initialize */
                       );
 
+/**
+ * Copy the values the user may set through a braid_StepStatus (old and tight
+ * fine tolx, r_space) back to the core.  Called after each user call that
+ * takes a braid_StepStatus.
+ */
+braid_Int
+_braid_StepStatusDone(braid_StepStatus  status     /**< structure to copy from */
+                      );
+
 /**
  * Initialize a braid_BufferStatus structure 
  */
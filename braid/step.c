@@ -37,7 +37,8 @@ _braid_Step(braid_Core         core,
    braid_Real         tol      = _braid_CoreElt(core, tol);
    braid_Int          iter     = _braid_CoreElt(core, niter);
    _braid_Grid      **grids    = _braid_CoreElt(core, grids);
-   braid_StepStatus   status   = (braid_StepStatus)core;
+   _braid_StepStatus  status_s;
+   braid_StepStatus   status   = &status_s;
    braid_Int          nrefine  = _braid_CoreElt(core, nrefine);
    braid_Int          gupper   = _braid_CoreElt(core, gupper);
    braid_Int          ilower   = _braid_GridElt(grids[level], ilower);
@@ -46,13 +47,18 @@ _braid_Step(braid_Core         core,
 
    braid_Int        ii;
 
+   _braid_StatusInit(core, (braid_Status) status);
+
    ii = index-ilower;
    _braid_StepStatusInit(ta[ii-1], ta[ii], index-1, tol, iter, level, nrefine, gupper, status);
 
    /* If ustop is set to NULL, use a default approach for setting it */
    if (ustop == NULL)
    {
-      _braid_GetUInit(core, level, index, u, &ustop);
+      _braid_Critical
+      {
+         _braid_GetUInit(core, level, index, u, &ustop);
+      }
    }
 
    if (level == 0)
@@ -74,6 +80,10 @@ _braid_Step(braid_Core         core,
          _braid_BaseStep(core, app,  ustop, fa[ii], u, level, status);
       }
    }
+   _braid_Critical
+   {
+      _braid_StepStatusDone(status);
+   }
 
    return _braid_error_flag;
 }
@@ -244,7 +244,14 @@ _braid_TapeSetSeed(braid_Core core)
          _braid_UGetVectorRef(core, 0, ic, &u_out);
 
          /* Set the seed using the adjoint variables */
-         _braid_CoreFcn(core, sum)(app, 1.0, optim->adjoints[iclocal], 0.0, u_out->bar->userVector);
+         if (u_out->bar->userVector == NULL)
+         {
+            _braid_CountFcn(core, clone)(app, optim->adjoints[iclocal], &(u_out->bar->userVector));
+         }
+         else
+         {
+            _braid_CountFcn(core, sum)(app, 1.0, optim->adjoints[iclocal], 0.0, u_out->bar->userVector);
+         }
       }
    }
 
@@ -0,0 +1,150 @@
+/*BHEADER**********************************************************************
+ * Copyright (c) 2013, Lawrence Livermore National Security, LLC.
+ * Produced at the Lawrence Livermore National Laboratory.
+ *
+ * This file is part of XBraid. For support, post issues to the XBraid Github page.
+ *
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License (as published by the Free Software
+ * Foundation) version 2.1 dated February 1999.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the IMPLIED WARRANTY OF MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE. See the terms and conditions of the GNU General Public
+ * License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc., 59
+ * Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+ ***********************************************************************EHEADER*/
+
+/** \file thread.c
+ * \brief Source code for doing the intervals of a processor on threads.  See
+ * braid_SetThreadSafe() for more information.
+ *
+ * The intervals of FCRelax, FRestrict and FInterp are independent, except
+ * that the first one receives from the left neighbor and the last ones send
+ * to the right neighbor.  The intervals in between are split into contiguous
+ * blocks, a few per OpenMP thread, and each block is done from right to left.
+ * Blocks are scheduled dynamically, so a thread that finishes early (cheap
+ * steps, e.g. fewer Newton iterations) takes the next block instead of idling.
+ * The result does not depend on the schedule.  The sweeps of FCRelax do not use
+ * these loops, but a task graph over the same blocks (see relax.c), so they
+ * are not separated by barriers.
+ * The status objects passed to the user are local to each call, while storage
+ * and memory management stay in critical sections on the core.  MPI calls are
+ * only made by the master thread.
+ */
+
+#include "_braid.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/*----------------------------------------------------------------------------
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_ThreadIntervals(braid_Core  core,
+                       braid_Int   level,
+                       braid_Int  *tlo_ptr,
+                       braid_Int  *thi_ptr)
+{
+#ifdef _OPENMP
+   _braid_Grid  **grids    = _braid_CoreElt(core, grids);
+   braid_Int      ncpoints = _braid_GridElt(grids[level], ncpoints);
+#endif
+
+   /* Empty range by default */
+   *tlo_ptr = 0;
+   *thi_ptr = -1;
+
+#ifdef _OPENMP
+   if ( _braid_CoreElt(core, thread_safe) && (omp_get_max_threads() > 1) &&
+        !_braid_CoreElt(core, adjoint) && !_braid_CoreElt(core, periodic) &&
+        (ncpoints > 3) )
+   {
+      *tlo_ptr = 1;
+      *thi_ptr = ncpoints-2;
+   }
+#endif
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_ThreadBlocks(braid_Int   tlo,
+                    braid_Int   thi,
+                    braid_Int  *nblocks_ptr)
+{
+   braid_Int  nblocks = 1;
+
+#ifdef _OPENMP
+   nblocks = _braid_min(_braid_ThreadBlockFactor*omp_get_max_threads(), thi-tlo+1);
+#endif
+   *nblocks_ptr = nblocks;
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_ThreadBlock(braid_Int   tlo,
+                   braid_Int   thi,
+                   braid_Int   nblocks,
+                   braid_Int   block,
+                   braid_Int  *blo_ptr,
+                   braid_Int  *bhi_ptr)
+{
+   braid_Int  n = thi-tlo+1;
+   braid_Int  q, r;
+
+   /* The first r blocks get one extra interval */
+   q = n / nblocks;
+   r = n % nblocks;
+   *blo_ptr = tlo + block*q + _braid_min(block, r);
+   *bhi_ptr = *blo_ptr + q - 1 + (block < r);
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_ThreadLoop(braid_Core          core,
+                  braid_Int           level,
+                  braid_Int           tlo,
+                  braid_Int           thi,
+                  _braid_IntervalFcn  fcn,
+                  void               *data)
+{
+   braid_Int  nblocks, block;
+
+   _braid_ThreadBlocks(tlo, thi, &nblocks);
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic,1)
+#endif
+   for (block = 0; block < nblocks; block++)
+   {
+      braid_Int  blo, bhi, interval;
+
+      /* The call level is per thread */
+      _braid_SetCallLevel(level, NULL);
+      _braid_ThreadBlock(tlo, thi, nblocks, block, &blo, &bhi);
+      for (interval = bhi; interval >= blo; interval--)
+      {
+         fcn(core, level, interval, data);
+      }
+   }
+
+   return _braid_error_flag;
+}
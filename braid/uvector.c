@@ -89,6 +89,352 @@ _braid_UGetIndex(braid_Core   core,
    return _braid_error_flag;
 }
 
+/*----------------------------------------------------------------------------
+ * C-points may be stored packed, in reduced precision (see
+ * braid_SetReducedStorage), out of core (see braid_SetOutOfCore) or as
+ * differences to a keyframe (see braid_SetDeltaStorage).  Returns
+ * in 'slot_ptr' the upack entry for point 'index' with local u-vector index
+ * 'iu', or NULL if the point is kept as a vector.
+ *----------------------------------------------------------------------------*/
+
+static braid_Int
+_braid_UPackSlot(braid_Core   core,
+                 braid_Int    level,
+                 braid_Int    index,
+                 braid_Int    iu,
+                 void      ***slot_ptr)
+{
+   _braid_Grid  **grids   = _braid_CoreElt(core, grids);
+   void         **upack   = _braid_GridElt(grids[level], upack);
+   braid_Int      cfactor = _braid_GridElt(grids[level], cfactor);
+
+   *slot_ptr = NULL;
+   if ( (upack != NULL) && _braid_IsCPoint(index, cfactor) )
+   {
+      *slot_ptr = &upack[iu];
+   }
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ * Returns true if point 'iu' has packed data in 'slot' or on file
+ *----------------------------------------------------------------------------*/
+
+static braid_Int
+_braid_UIsPacked(braid_Core   core,
+                 braid_Int    level,
+                 braid_Int    iu,
+                 void       **slot)
+{
+   _braid_Grid  **grids  = _braid_CoreElt(core, grids);
+   braid_Int     *uspill = _braid_GridElt(grids[level], uspill);
+
+   return ( (*slot != NULL) || ((uspill != NULL) && (uspill[iu] > 0)) );
+}
+
+/*----------------------------------------------------------------------------
+ * Discards the packed data of point 'iu' (in 'slot' or on file)
+ *----------------------------------------------------------------------------*/
+
+static braid_Int
+_braid_UDropPacked(braid_Core   core,
+                   braid_Int    level,
+                   braid_Int    iu,
+                   void       **slot)
+{
+   _braid_Grid  **grids  = _braid_CoreElt(core, grids);
+   braid_Int     *uspill = _braid_GridElt(grids[level], uspill);
+
+   _braid_TFree(*slot);
+   if (uspill != NULL)
+   {
+      uspill[iu] = 0;
+   }
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ * With delta storage (see braid_SetDeltaStorage), the local C-points are
+ * grouped by their ordinal c (0 for the first local C-point).  These map the
+ * local u-vector index 'iu' of a C-point to c and back.
+ *----------------------------------------------------------------------------*/
+
+static braid_Int
+_braid_UDeltaOrdinal(braid_Core   core,
+                     braid_Int    level,
+                     braid_Int    iu,
+                     braid_Int   *c_ptr)
+{
+   _braid_Grid  **grids   = _braid_CoreElt(core, grids);
+   braid_Int      storage = _braid_CoreElt(core, storage);
+   braid_Int      ilower  = _braid_GridElt(grids[level], ilower);
+   braid_Int      clower  = _braid_GridElt(grids[level], clower);
+   braid_Int      cfactor = _braid_GridElt(grids[level], cfactor);
+
+   if ( (storage < 0) || (level < storage) )
+   {
+      *c_ptr = iu;                              /* only C-points are stored */
+   }
+   else
+   {
+      *c_ptr = (ilower + iu - clower) / cfactor;
+   }
+
+   return _braid_error_flag;
+}
+
+static braid_Int
+_braid_UDeltaIndex(braid_Core   core,
+                   braid_Int    level,
+                   braid_Int    c,
+                   braid_Int   *iu_ptr)
+{
+   _braid_Grid  **grids   = _braid_CoreElt(core, grids);
+   braid_Int      storage = _braid_CoreElt(core, storage);
+   braid_Int      ilower  = _braid_GridElt(grids[level], ilower);
+   braid_Int      clower  = _braid_GridElt(grids[level], clower);
+   braid_Int      cfactor = _braid_GridElt(grids[level], cfactor);
+
+   if ( (storage < 0) || (level < storage) )
+   {
+      *iu_ptr = c;
+   }
+   else
+   {
+      *iu_ptr = clower + c*cfactor - ilower;
+   }
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ * Stores 'size' bytes of packed data 'raw' in 'slot' for point 'iu' as a
+ * difference to the reference of its group.  The first point of a group
+ * (re)sets the reference, and the other packed points of the group are then
+ * re-encoded against it.  Note that 'raw' may be the core scratch buffer.
+ *----------------------------------------------------------------------------*/
+
+static braid_Int
+_braid_UPackDelta(braid_Core   core,
+                  braid_Int    level,
+                  braid_Int    iu,
+                  void       **slot,
+                  void        *raw,
+                  braid_Int    size)
+{
+   _braid_Grid  **grids    = _braid_CoreElt(core, grids);
+   void         **upack    = _braid_GridElt(grids[level], upack);
+   void         **uref     = _braid_GridElt(grids[level], uref);
+   braid_Int      ncpoints = _braid_GridElt(grids[level], ncpoints);
+   braid_Int      keyframe = _braid_CoreElt(core, delta_keyframe);
+   braid_Int      c, g, m, ju, ref_size, data_size, packed_size;
+   void          *ref, *data, *packed;
+
+   _braid_UDeltaOrdinal(core, level, iu, &c);
+   g = c / keyframe;
+
+   if ( (uref[g] == NULL) || (c % keyframe == 0) )
+   {
+      _braid_DeltaEncode(core, NULL, raw, size, &ref, &ref_size);
+      for (m = g*keyframe; (m < (g+1)*keyframe) && (m < ncpoints); m++)
+      {
+         _braid_UDeltaIndex(core, level, m, &ju);
+         if ( (ju != iu) && (upack[ju] != NULL) )
+         {
+            _braid_DeltaDecode(core, uref[g], upack[ju], &data, &data_size);
+            _braid_DeltaEncode(core, ref, data, data_size, &packed, &packed_size);
+            free(upack[ju]);
+            upack[ju] = packed;
+         }
+      }
+      _braid_TFree(uref[g]);
+      uref[g] = ref;
+
+      /* The decoding above may have overwritten the scratch buffer */
+      _braid_DeltaData(ref, &raw, &size);
+   }
+
+   _braid_DeltaEncode(core, uref[g], raw, size, slot, &size);
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ * Packs u into 'slot' for point 'iu', as a difference to a keyframe with delta
+ * storage, otherwise in reduced precision if set on this level, and spills it
+ * to file if out of core
+ *----------------------------------------------------------------------------*/
+
+static braid_Int
+_braid_UPack(braid_Core         core,
+             braid_Int          level,
+             braid_Int          iu,
+             void             **slot,
+             braid_BaseVector   u)
+{
+   braid_App           app     = _braid_CoreElt(core, app);
+   braid_Int           reduced = _braid_CoreElt(core, reduced_storage);
+   _braid_BufferStatus bstatus_s;
+   braid_BufferStatus  bstatus = &bstatus_s;
+   braid_Int           size;
+   void               *buffer;
+
+   _braid_StatusInit(core, (braid_Status) bstatus);
+
+   _braid_BufferStatusInit( 0, 0, bstatus );
+   _braid_BaseBufSize(core, app,  &size, bstatus);
+   _braid_StorageScratch(core, size, &buffer);
+
+   /* Note that bufpack may return a size smaller than bufsize */
+   _braid_StatusElt(bstatus, size_buffer) = size;
+   _braid_BaseBufPack(core, app,  u, buffer, bstatus);
+   size = _braid_StatusElt(bstatus, size_buffer);
+
+   _braid_UDropPacked(core, level, iu, slot);
+   if (_braid_GridElt(_braid_CoreElt(core, grids)[level], uref) != NULL)
+   {
+      _braid_UPackDelta(core, level, iu, slot, buffer, size);
+   }
+   else
+   {
+      _braid_ReducePrecision(core, buffer, size, (reduced > -1) && (level >= reduced),
+                             slot, &size);
+      _braid_OocSpill(core, level, iu, size, slot);
+   }
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ * Returns a new vector unpacked from the data of point 'iu' (in 'slot' or on
+ * file)
+ *----------------------------------------------------------------------------*/
+
+static braid_Int
+_braid_UUnpack(braid_Core         core,
+               braid_Int          level,
+               braid_Int          iu,
+               void             **slot,
+               braid_BaseVector  *u_ptr)
+{
+   braid_App           app     = _braid_CoreElt(core, app);
+   void              **uref    = _braid_GridElt(_braid_CoreElt(core, grids)[level], uref);
+   _braid_BufferStatus bstatus_s;
+   braid_BufferStatus  bstatus = &bstatus_s;
+   braid_Int           size, c;
+   void               *packed, *buffer;
+
+   _braid_StatusInit(core, (braid_Status) bstatus);
+
+   packed = *slot;
+   if (uref != NULL)
+   {
+      _braid_UDeltaOrdinal(core, level, iu, &c);
+      _braid_DeltaDecode(core, uref[c / _braid_CoreElt(core, delta_keyframe)], packed,
+                         &buffer, &size);
+   }
+   else
+   {
+      if (packed == NULL)
+      {
+         _braid_OocFetch(core, level, iu, &packed);
+      }
+      _braid_ExpandPrecision(core, packed, &buffer, &size);
+      if (packed != *slot)
+      {
+         free(packed);
+      }
+   }
+   _braid_BufferStatusInit( 0, 0, bstatus );
+   _braid_BaseBufUnpack(core, app,  buffer, u_ptr, bstatus);
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ * Packs the C-points 'ilo' to 'ihi' on grid 'level' that were expanded by
+ * _braid_UGetVectorRef again.  Call only when no references to them are held.
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_URepack(braid_Core  core,
+               braid_Int   level,
+               braid_Int   ilo,
+               braid_Int   ihi)
+{
+   braid_App            app    = _braid_CoreElt(core, app);
+   _braid_Grid        **grids  = _braid_CoreElt(core, grids);
+   braid_BaseVector    *ua     = _braid_GridElt(grids[level], ua);
+   braid_Int            index, iu, sflag;
+   void               **slot;
+
+   if (_braid_GridElt(grids[level], upack) == NULL)
+   {
+      return _braid_error_flag;
+   }
+
+   for (index = ilo; index <= ihi; index++)
+   {
+      _braid_UGetIndex(core, level, index, &iu, &sflag);
+      if ( (sflag == 0) && (ua[iu] != NULL) )
+      {
+         _braid_UPackSlot(core, level, index, iu, &slot);
+         if (slot != NULL)
+         {
+            _braid_UPack(core, level, iu, slot, ua[iu]);
+            _braid_BaseFree(core, app,  ua[iu]);
+            ua[iu] = NULL;
+         }
+      }
+   }
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_UDeltaStats(braid_Core   core,
+                   braid_Int    level,
+                   braid_Real  *stats)
+{
+   _braid_Grid  **grids    = _braid_CoreElt(core, grids);
+   void         **upack    = _braid_GridElt(grids[level], upack);
+   void         **uref     = _braid_GridElt(grids[level], uref);
+   braid_Int      nupoints = _braid_GridElt(grids[level], nupoints);
+   braid_Int      keyframe = _braid_CoreElt(core, delta_keyframe);
+   braid_Int      raw_size, size, ii;
+
+   stats[0] = stats[1] = 0.0;
+   if (uref == NULL)
+   {
+      return _braid_error_flag;
+   }
+
+   for (ii = 0; ii < nupoints; ii++)
+   {
+      if (upack[ii] != NULL)
+      {
+         _braid_DeltaSizes(upack[ii], &raw_size, &size);
+         stats[0] += raw_size;
+         stats[1] += size;
+      }
+   }
+   for (ii = 0; ii <= nupoints/keyframe; ii++)
+   {
+      if (uref[ii] != NULL)
+      {
+         _braid_DeltaSizes(uref[ii], &raw_size, &size);
+         stats[1] += size;
+      }
+   }
+
+   return _braid_error_flag;
+}
+
 /*----------------------------------------------------------------------------
  * Returns a reference to the local u-vector on grid 'level' at point 'index'.
  * If the u-vector is not stored, returns NULL. The referred u-vector might
@@ -105,10 +451,19 @@ _braid_UGetVectorRef(braid_Core         core,
    braid_BaseVector    *ua    = _braid_GridElt(grids[level], ua);
    braid_BaseVector     u     = NULL;
    braid_Int            iu, sflag;
+   void               **slot;
 
    _braid_UGetIndex(core, level, index, &iu, &sflag);
    if (sflag>-2) // We have a full point or a shell (iu>=0)
    {
+      /* Expand a packed point, it is kept as a vector until the next
+       * _braid_USetVector or _braid_URepack */
+      _braid_UPackSlot(core, level, index, iu, &slot);
+      if ( (slot != NULL) && _braid_UIsPacked(core, level, iu, slot) )
+      {
+         _braid_UUnpack(core, level, iu, slot, &ua[iu]);
+         _braid_UDropPacked(core, level, iu, slot);
+      }
       u = ua[iu];
    }
 
@@ -133,18 +488,33 @@ _braid_USetVectorRef(braid_Core        core,
    _braid_Grid        **grids = _braid_CoreElt(core, grids);
    braid_BaseVector    *ua    = _braid_GridElt(grids[level], ua);
    braid_Int            iu, sflag;
+   void               **slot;
 
    _braid_UGetIndex(core, level, index, &iu, &sflag);
    // If sflag ==0, we have a full point, if sflag == -1, we have a shell
    if (sflag == 0)
    {
+      /* The reference replaces any packed data */
+      _braid_UPackSlot(core, level, index, iu, &slot);
+      if (slot != NULL)
+      {
+         _braid_UDropPacked(core, level, iu, slot);
+      }
       ua[iu] = u;
    }
    else if (sflag == -1)
    {
       braid_App    app = _braid_CoreElt(core, app);
-      _braid_BaseSFree(core,  app, u);
-      ua[iu] = u;
+      if ( (ua[iu] != NULL) && (ua[iu] != u) )
+      {
+         /* Keep the shell already stored at this point */
+         _braid_BaseFree(core, app,  u);
+      }
+      else
+      {
+         _braid_BaseSFree(core,  app, u);
+         ua[iu] = u;
+      }
    }
 
    return _braid_error_flag;
@@ -170,6 +540,7 @@ _braid_UGetVector(braid_Core         core,
    _braid_CommHandle   *recv_handle = _braid_GridElt(grids[level], recv_handle);
    braid_BaseVector     u           = NULL;
    braid_Int            iu, sflag;
+   void               **slot;
 
    if (index == recv_index)
    {
@@ -187,7 +558,15 @@ _braid_UGetVector(braid_Core         core,
       _braid_UGetIndex(core, level, index, &iu, &sflag);
       if (sflag == 0)
       {
-         _braid_BaseClone(core, app,  ua[iu], &u);
+         _braid_UPackSlot(core, level, index, iu, &slot);
+         if ( (slot != NULL) && _braid_UIsPacked(core, level, iu, slot) )
+         {
+            _braid_UUnpack(core, level, iu, slot, &u);   /* expand a packed point */
+         }
+         else
+         {
+            _braid_BaseClone(core, app,  ua[iu], &u);
+         }
       }
       else if (sflag == -1)
       {
@@ -207,6 +586,11 @@ _braid_UGetVector(braid_Core         core,
  * u-vector is moved into core storage instead of copied.  If the u-vector is
  * not stored, nothing is done or only the shell is copied/moved when the shellvector
  * feature is used.
+ *
+ * A copy overwrites the vector already stored at 'index' when the user
+ * provides a copy routine, so no vector is freed and cloned.  Callers that are
+ * done with u should pass 'move' to avoid the copy altogether; for a point
+ * that is not stored, this just frees u.
  *----------------------------------------------------------------------------*/
 
 braid_Int
@@ -222,8 +606,16 @@ _braid_USetVector(braid_Core        core,
    braid_Int            send_index  = _braid_GridElt(grids[level], send_index);
    _braid_CommHandle   *send_handle = _braid_GridElt(grids[level], send_handle);
    braid_Int            iu, sflag;
+   void               **slot;
 
-   if (index == send_index)
+   if ( (index == send_index) && (send_handle != NULL) &&
+        (_braid_CommHandleElt(send_handle, nvectors) > 0) )
+   {
+      /* Pack into the aggregated send (posted once it is complete) */
+      _braid_CommSendAppend(core, send_handle, 0, u);
+      _braid_GridElt(grids[level], send_index)  = _braid_SendIndexNull;
+   }
+   else if (index == send_index)
    {
       /* Post send to neighbor processor */
       _braid_CommSendInit(core, level, index, u, &send_handle);
@@ -234,6 +626,29 @@ _braid_USetVector(braid_Core        core,
    _braid_UGetIndex(core, level, index, &iu, &sflag);
    if (sflag == 0) // We have a full point
    {
+      _braid_UPackSlot(core, level, index, iu, &slot);
+   }
+   if ( (sflag == 0) && (slot != NULL) ) // We have a packed point
+   {
+      if (ua[iu] != NULL)
+      {
+         _braid_BaseFree(core, app,  ua[iu]);
+         ua[iu] = NULL;
+      }
+      _braid_UPack(core, level, iu, slot, u);
+      if (move)
+      {
+         _braid_BaseFree(core, app,  u);
+      }
+   }
+   else if (sflag == 0) // We have a full point
+   {
+      if ( !move && (ua[iu] != NULL) && (_braid_CoreElt(core, copy) != NULL) &&
+           !_braid_CoreElt(core, adjoint) )
+      {
+         _braid_BaseCopy(core, app,  u, ua[iu]);   /* copy into the old vector */
+         return _braid_error_flag;
+      }
       if (ua[iu] != NULL)
       {
          _braid_BaseFree(core, app,  ua[iu]);
@@ -251,9 +666,13 @@ _braid_USetVector(braid_Core        core,
    {
       if (ua[iu] != NULL)
       {
-         _braid_BaseFree(core, app,  ua[iu]);
+         /* The shell of a point persists across sweeps, keep it in place */
+         if (move)
+         {
+            _braid_BaseFree(core, app,  u);
+         }
       }
-      if (move)
+      else if (move)
       {
          // We are on an F-point, with shellvector option. We only keep the shell.
          _braid_BaseSFree(core,  app, u);
@@ -291,6 +710,7 @@ _braid_UCommInitBasic(braid_Core  core,
    braid_Int            send_index  = _braid_SendIndexNull;
    _braid_CommHandle   *recv_handle = NULL;
    _braid_CommHandle   *send_handle = NULL;
+   braid_BaseVector     u;
    braid_Int            iu, sflag;
 
    /* Post receive */
@@ -312,7 +732,8 @@ _braid_UCommInitBasic(braid_Core  core,
             // We should never get here : we do not communicate shells...
             abort();
          }
-         _braid_CommSendInit(core, level, send_index, ua[iu], &send_handle);
+         _braid_UGetVectorRef(core, level, send_index, &u);
+         _braid_CommSendInit(core, level, send_index, u, &send_handle);
          send_index = _braid_SendIndexNull;
       }
    }
@@ -327,6 +748,11 @@ _braid_UCommInitBasic(braid_Core  core,
 
 /*----------------------------------------------------------------------------
  * Working on all intervals
+ *
+ * The callers sweep the intervals from right to left, so the interval holding
+ * a deferred iupper send is processed first and _braid_USetVector posts the
+ * send as soon as that value is computed.  The receive into ua[-1] is needed
+ * by the left-most interval, which is processed last.
  *----------------------------------------------------------------------------*/
 
 braid_Int
@@ -342,7 +768,7 @@ _braid_UCommInit(braid_Core  core,
    braid_Int            send_index  = _braid_SendIndexNull;
    _braid_CommHandle   *recv_handle = NULL;
    _braid_CommHandle   *send_handle = NULL;
-   braid_Int            iu, sflag;
+   braid_BaseVector     u;
    
    /* Note that this routine works for the case of all points being C-points, 
     * i.e., cfactor = 1.  A send and receive are always posted. */
@@ -356,8 +782,79 @@ _braid_UCommInit(braid_Core  core,
       /* Only post send if iupper is a C-point, otherwise compute and send later */
       if ( _braid_IsCPoint(iupper, cfactor) )
       {
-         _braid_UGetIndex(core, level, iupper, &iu, &sflag);
-         _braid_CommSendInit(core, level, iupper, ua[iu], &send_handle);
+         _braid_UGetVectorRef(core, level, iupper, &u);
+         _braid_CommSendInit(core, level, iupper, u, &send_handle);
+         send_index = _braid_SendIndexNull;
+      }
+      else
+      {
+         send_index = iupper;
+      }
+   }
+
+   _braid_GridElt(grids[level], recv_index)  = recv_index ;
+   _braid_GridElt(grids[level], send_index)  = send_index ;
+   _braid_GridElt(grids[level], recv_handle) = recv_handle;
+   _braid_GridElt(grids[level], send_handle) = send_handle;
+
+   return _braid_error_flag;
+}
+
+/*----------------------------------------------------------------------------
+ * Working on all intervals, with the coarse-grid boundary value aggregated
+ * into the same messages (see _braid_FRestrict)
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_UCommInitAgg(braid_Core         core,
+                    braid_Int          level,
+                    braid_Int          recv_agg,
+                    braid_Int          send_agg,
+                    braid_BaseVector  *c_vector_ptr)
+{
+   _braid_Grid        **grids       = _braid_CoreElt(core, grids);
+   braid_Int            ilower      = _braid_GridElt(grids[level], ilower);
+   braid_Int            iupper      = _braid_GridElt(grids[level], iupper);
+   braid_Int            cfactor     = _braid_GridElt(grids[level], cfactor);
+   braid_BaseVector    *ua          = _braid_GridElt(grids[level], ua);
+   braid_Int            recv_index  = _braid_RecvIndexNull;
+   braid_Int            send_index  = _braid_SendIndexNull;
+   _braid_CommHandle   *recv_handle = NULL;
+   _braid_CommHandle   *send_handle = NULL;
+   braid_BaseVector    *vector_ptrs[2];
+   braid_BaseVector     u;
+
+   if (ilower <= iupper)
+   {
+      /* Post receive */
+      if (recv_agg)
+      {
+         vector_ptrs[0] = &ua[-1];
+         vector_ptrs[1] = c_vector_ptr;
+         _braid_CommRecvInitAgg(core, level, ilower-1, 2, vector_ptrs, &recv_handle);
+      }
+      else
+      {
+         _braid_CommRecvInit(core, level, ilower-1, &ua[-1], &recv_handle);
+      }
+      recv_index = ilower-1;
+
+      /* Pack iupper now if it is a C-point, otherwise compute and pack later */
+      if (send_agg)
+      {
+         _braid_CommSendInitAgg(core, level, iupper, 2, &send_handle);
+      }
+      if ( _braid_IsCPoint(iupper, cfactor) )
+      {
+         _braid_UGetVectorRef(core, level, iupper, &u);
+         if (send_agg)
+         {
+            _braid_CommSendAppend(core, send_handle, 0, u);
+         }
+         else
+         {
+            _braid_CommSendInit(core, level, iupper, u, &send_handle);
+         }
          send_index = _braid_SendIndexNull;
       }
       else
@@ -391,7 +888,7 @@ _braid_UCommInitF(braid_Core  core,
    braid_Int            send_index  = _braid_SendIndexNull;
    _braid_CommHandle   *recv_handle = NULL;
    _braid_CommHandle   *send_handle = NULL;
-   braid_Int            iu, sflag;
+   braid_BaseVector     u;
 
    if (ilower <= iupper)
    {
@@ -408,8 +905,8 @@ _braid_UCommInitF(braid_Core  core,
        * computed later, it is sent. */
       if ( _braid_IsCPoint(iupper, cfactor) && _braid_IsFPoint(iupper+1, cfactor))
       {
-         _braid_UGetIndex(core, level, iupper, &iu, &sflag);
-         _braid_CommSendInit(core, level, iupper, ua[iu], &send_handle);
+         _braid_UGetVectorRef(core, level, iupper, &u);
+         _braid_CommSendInit(core, level, iupper, u, &send_handle);
          send_index = _braid_SendIndexNull;
       }
       else if ( _braid_IsFPoint(iupper+1, cfactor) )
@@ -426,6 +923,33 @@ _braid_UCommInitF(braid_Core  core,
    return _braid_error_flag;
 }
 
+/*----------------------------------------------------------------------------
+ * Not used for adjoint runs, where BufUnpack is recorded on the tape and must
+ * stay in order with the other actions.
+ *----------------------------------------------------------------------------*/
+
+braid_Int
+_braid_UCommProgress(braid_Core  core,
+                     braid_Int   level)
+{
+   _braid_Grid        **grids       = _braid_CoreElt(core, grids);
+   _braid_CommHandle   *recv_handle = _braid_GridElt(grids[level], recv_handle);
+   _braid_CommHandle   *send_handle = _braid_GridElt(grids[level], send_handle);
+
+   if (_braid_CoreElt(core, adjoint))
+   {
+      return _braid_error_flag;
+   }
+
+   /* The recv_index is kept, so _braid_UGetVector still picks up ua[-1] */
+   _braid_CommTest(core, &recv_handle);
+   _braid_CommTest(core, &send_handle);
+   _braid_GridElt(grids[level], recv_handle) = recv_handle;
+   _braid_GridElt(grids[level], send_handle) = send_handle;
+
+   return _braid_error_flag;
+}
+
 /*----------------------------------------------------------------------------
  * Finish up communication
  *----------------------------------------------------------------------------*/
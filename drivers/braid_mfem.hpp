@@ -254,6 +254,7 @@ struct BraidOptions : public OptionsParser
    int    min_coarse;
    int    nrelax;
    int    nrelax0;
+   const char *relax_sched;
    double tol;
    bool   rtol;
    int    tnorm;
@@ -262,6 +263,8 @@ struct BraidOptions : public OptionsParser
    int    cfactor0;
    int    max_iter;
    int    nfmg_Vcyc;
+   int    cycle;
+   int    ncycles;
    bool   spatial_coarsen;
    int    access_level;
    int    print_level;
@@ -886,6 +889,7 @@ BraidOptions::BraidOptions(int argc, char *argv[])
    min_coarse       = 2;
    nrelax           = 1;
    nrelax0          = -1;    // if > -1, use as nrelax for level 0
+   relax_sched      = "";    // if not empty, relaxation schedule on all levels
    tol              = 1e-9;
    rtol             = true;
    tnorm            = 2;
@@ -894,6 +898,8 @@ BraidOptions::BraidOptions(int argc, char *argv[])
    cfactor0         = -1;    // if > -1, use as cfactor for level 0
    max_iter         = 100;
    nfmg_Vcyc        = 0;     // if > 0, enable FMG and use as nfmg_Vcyc
+   cycle            = 0;     // 0:V, 1:F, 2:W (braid_CYCLE_*)
+   ncycles          = -1;    // if > 0, use as ncycles on all levels
    spatial_coarsen  = false; // if true, enable spatial coarsening
    access_level     = 1;
    print_level      = 2;
@@ -913,6 +919,8 @@ BraidOptions::BraidOptions(int argc, char *argv[])
              "Number of F-C relaxations.");
    AddOption(&nrelax0, "-nu0", "--num-fc-relax-level-0",
              "Number of F-C relaxations on level 0.");
+   AddOption(&relax_sched, "-relax", "--relax-schedule",
+             "Relaxation schedule on all levels, e.g., FCF or FCC0.7F.");
    AddOption(&tol, "-tol", "--tolerance", "Stopping tolerance.");
    AddOption(&rtol, "-reltol", "--relative-tolerance", "-abstol",
              "--absolute-tolerance",
@@ -930,6 +938,10 @@ BraidOptions::BraidOptions(int argc, char *argv[])
              "Maximum number of iterations.");
    AddOption(&nfmg_Vcyc, "-fmg", "--fmg-v-cycles",
              "Number of V-cycles to use at each FMG level (0:off).");
+   AddOption(&cycle, "-cycle", "--cycle-type",
+             "Cycle type: 0:V-cycle, 1:F-cycle, 2:W-cycle.");
+   AddOption(&ncycles, "-nc", "--num-cycles",
+             "Number of coarse-grid corrections on each level (-1:from cycle type).");
    AddOption(&spatial_coarsen, "-sc", "--spatial-coarsen", "-no-sc",
              "--no-spatial-coarsen", "Enable/disable spatial coarsening.");
    AddOption(&access_level, "-access", "--access-level",
@@ -994,6 +1006,8 @@ void BraidOptions::SetBraidCoreOptions(BraidCore &core)
    core.SetNRelax(-1, nrelax);
    if (nrelax0 > -1)
       core.SetNRelax(0, nrelax0);
+   if (relax_sched[0] != '\0')
+      core.SetRelaxSchedule(-1, relax_sched);
    rtol ? core.SetRelTol(tol) : core.SetAbsTol(tol);
    core.SetCFactor(-1, cfactor);
    core.SetAggCFactor(cfactor0);
@@ -1010,6 +1024,11 @@ void BraidOptions::SetBraidCoreOptions(BraidCore &core)
       core.SetFMG();
       core.SetNFMGVcyc(nfmg_Vcyc);
    }
+   core.SetCycle(cycle);
+   if (ncycles > 0)
+   {
+      core.SetNCycles(-1, ncycles);
+   }
 }
 
 void SpaceTimeMeshInfo::Reinitialize(int _max_levels)
@@ -113,6 +113,21 @@ my_Init(braid_App     app,
    return 0;
 }
 
+/* Optional, allocate a zero vector (used for the adjoint vectors) */
+int
+my_InitZero(braid_App     app,
+            double        t,
+            braid_Vector *u_ptr)
+{
+   my_Vector *u;
+
+   u = (my_Vector *) malloc(sizeof(my_Vector));
+   (u->value) = 0.0;
+   *u_ptr = u;
+
+   return 0;
+}
+
 int
 my_Clone(braid_App     app,
          braid_Vector  u,
@@ -324,6 +339,8 @@ int main (int argc, char *argv[])
    int           rank;
    double        lambda; 
    double        objective;
+   int           initzero;
+   int           arg_index;
 
    /* Define time domain: ntime intervals */
    ntime  = 50;
@@ -336,6 +353,16 @@ int main (int argc, char *argv[])
    /* Initialize MPI */
    MPI_Init(&argc, &argv);
    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+   /* Parse command line (-initzero: create the adjoint vectors with my_InitZero) */
+   initzero = 0;
+   for (arg_index = 1; arg_index < argc; arg_index++)
+   {
+      if ( strcmp(argv[arg_index], "-initzero") == 0 )
+      {
+         initzero = 1;
+      }
+   }
    
    /* set up app structure */
    app = (my_App *) malloc(sizeof(my_App));
@@ -361,6 +388,10 @@ int main (int argc, char *argv[])
    braid_SetPrintLevel( core, 1);           /* Print level: report norms of state and adjoint while iterating in drive() */
    braid_SetAbsTol(core, 1e-6);             /* Tolerance on state residual norm */
    braid_SetAbsTolAdjoint(core, 1e-6);      /* Tolerance on adjoint residual norm */
+   if (initzero)
+   {
+      braid_SetInitZero(core, my_InitZero); /* Allocate adjoint vectors as zero */
+   }
 
    /* Run simulation and adjoint-based gradient computation */
    braid_Drive(core);
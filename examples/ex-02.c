@@ -62,8 +62,8 @@ typedef struct _braid_App_struct
    double    xstart;       /* Define the spatial domain */
    double    xstop;
    int       nspace;
-   double    matrix[3];    /* the three point spatial discretization stencil */
    double *  g;            /* temporary vector for inversions and mat-vecs */
+   int       threads;      /* Step and Residual may be called by several threads at once */
    double *  sc_info;      /* Runtime information that tracks the space-time grids visited */
    int       print_level;  /* Level of output desired by user (see the -help message below) */
 } my_App;
@@ -101,6 +101,8 @@ int my_Step(braid_App        app,
    double tstop;              /* evolve to this time*/
    int level, i;
    double deltaX, deltaT;
+   double matrix[3];          /* the three point spatial discretization stencil */
+   double *g = (app->g);
 
    braid_StepStatusGetLevel(status, &level);
    braid_StepStatusGetTstartTstop(status, &tstart, &tstop);
@@ -119,8 +121,17 @@ int my_Step(braid_App        app,
    /* Take backward Euler step 
     * Note: if an iterative solver were used, ustop->values would 
     *       contain the XBraid's best initial guess. */
+   if (app->threads)
+   {
+      /* each thread needs its own temporary vector */
+      g = (double*) malloc( (u->size)*sizeof(double) );
+   }
    take_step(u->values, u->size, tstop, app->xstart, deltaX, deltaT,
-         app->matrix, app->g); 
+         matrix, g); 
+   if (app->threads)
+   {
+      free(g);
+   }
 
    /* Store info on space-time grids visited during the simulation */
    (app->sc_info)[ (2*level) ] = deltaX;
@@ -185,6 +196,26 @@ my_Clone(braid_App     app,
    return 0;
 }
 
+/*--------------------------------------------------------------------------
+ * my_Copy is an optional routine for recycling vectors (see braid_SetCopy),
+ * it is only called for vectors of the same size
+ *--------------------------------------------------------------------------*/
+
+int
+my_Copy(braid_App     app,
+        braid_Vector  u,
+        braid_Vector  v)
+{
+   int i;
+
+   for (i = 0; i < (u->size); i++)
+   {
+      (v->values)[i] = (u->values)[i];
+   }
+
+   return 0;
+}
+
 int
 my_Free(braid_App    app,
         braid_Vector u)
@@ -318,6 +349,23 @@ my_BufUnpack(braid_App           app,
    return 0;
 }
 
+/*--------------------------------------------------------------------------
+ * my_BufView is an optional routine for sending vectors in place, without
+ * packing them (see braid_SetBufView)
+ *--------------------------------------------------------------------------*/
+
+int
+my_BufView(braid_App      app,
+           braid_Vector   u,
+           void         **data_ptr,
+           int           *size_ptr)
+{
+   *data_ptr = u->values;
+   *size_ptr = (u->size)*sizeof(double);
+
+   return 0;
+}
+
 
 /*--------------------------------------------------------------------------
  * my_Residual, my_Coarsen and my_Refine are advanced XBraid options, ignore
@@ -334,23 +382,34 @@ my_Residual(braid_App        app,
    double tstop;              /* evolve to this time*/
    int i;
    double x, deltaX, deltaT;
+   double matrix[3];          /* the three point spatial discretization stencil */
+   double *g = (app->g);
 
    braid_StepStatusGetTstartTstop(status, &tstart, &tstop);
    deltaT = tstop - tstart;
    deltaX = (app->xstop - app->xstart) / (ustop->size - 1.0);
    
    /* Set up matrix stencil for 1D heat equation*/
-   compute_stencil(deltaX, deltaT, app->matrix);
+   compute_stencil(deltaX, deltaT, matrix);
    
    /* Residual r = A*xstop - r - forcing - boundary 
     *   note: there are no boundary terms here */
-   matvec_tridiag(ustop->values, app->g, ustop->size, app->matrix);
+   if (app->threads)
+   {
+      /* each thread needs its own temporary vector */
+      g = (double*) malloc( (ustop->size)*sizeof(double) );
+   }
+   matvec_tridiag(ustop->values, g, ustop->size, matrix);
    x = app->xstart;
    for(i = 0; i < r->size; i++)
    {
-      r->values[i] = app->g[i] - r->values[i] - deltaT*forcing(tstop, x);
+      r->values[i] = g[i] - r->values[i] - deltaT*forcing(tstop, x);
       x = x + deltaX;
    }
+   if (app->threads)
+   {
+      free(g);
+   }
 
    return 0;
 }
@@ -459,6 +518,19 @@ int main (int argc, char *argv[])
    int       print_level   = 2;
    int       access_level  = 1;
    int       use_sequential= 0;
+   int       persistent    = 0;
+   int       bufview       = 0;
+   int       comm_agg      = 0;
+   int       compress      = 0;
+   double    compress_tol  = 0.0;
+   int       shm           = 0;
+   int       vpool         = -1;
+   int       reduced       = -1;
+   int       ooc           = -1;
+   int       delta         = 0;
+   int       threads       = 0;
+   int       cycle         = -1;
+   char     *relax         = NULL;
 
    /* Initialize MPI */
    MPI_Init(&argc, &argv);
@@ -491,7 +563,19 @@ int main (int argc, char *argv[])
             printf("   -mi   <max_iter>     : set max iterations\n");
             printf("   -fmg                 : use FMG cycling\n");
             printf("   -sc                  : use spatial coarsening by factor of 2 each level\n");
-            printf("   -res                 : use my residual\n\n");
+            printf("   -res                 : use my residual\n");
+            printf("   -persist             : use persistent MPI requests for the neighbor exchange\n");
+            printf("   -view                : send vectors in place with my_BufView (zero-copy)\n");
+            printf("   -agg                 : aggregate messages to the same neighbor\n");
+            printf("   -compress <m> <tol>  : compress messages, 1: lossless, 2: lossy with error tol*residual\n");
+            printf("   -shm                 : exchange messages with on-node neighbors through shared memory\n");
+            printf("   -vpool <n>           : recycle up to n freed vectors with my_Copy\n");
+            printf("   -reduced <l>         : store C-points on levels >= l in single precision\n");
+            printf("   -ooc <w>             : keep level 0 C-points out of core, except for the first w\n");
+            printf("   -delta <k>           : store level 0 C-points as differences to every k-th one\n");
+            printf("   -threads             : relax with OpenMP threads (needs make openmp=yes)\n");
+            printf("   -cycle <c>           : cycle type, 0: V-cycle, 1: F-cycle, 2: W-cycle\n");
+            printf("   -relax <sched>       : relaxation schedule, e.g., FCF or FC0.7C1.2F\n\n");
             printf("   -print_level <l>     : sets the print_level (default: 1) \n");
             printf("                          0 - no output to standard out \n");
             printf("                          2 - Basic convergence information and hierarchy statistics\n");
@@ -579,6 +663,67 @@ int main (int argc, char *argv[])
          arg_index++;
          res = 1;
       }
+      else if ( strcmp(argv[arg_index], "-persist") == 0 )
+      {
+         arg_index++;
+         persistent = 1;
+      }
+      else if ( strcmp(argv[arg_index], "-view") == 0 )
+      {
+         arg_index++;
+         bufview = 1;
+      }
+      else if ( strcmp(argv[arg_index], "-agg") == 0 )
+      {
+         arg_index++;
+         comm_agg = 1;
+      }
+      else if ( strcmp(argv[arg_index], "-compress") == 0 )
+      {
+         arg_index++;
+         compress = atoi(argv[arg_index++]);
+         compress_tol = atof(argv[arg_index++]);
+      }
+      else if ( strcmp(argv[arg_index], "-shm") == 0 )
+      {
+         arg_index++;
+         shm = 1;
+      }
+      else if ( strcmp(argv[arg_index], "-vpool") == 0 )
+      {
+         arg_index++;
+         vpool = atoi(argv[arg_index++]);
+      }
+      else if ( strcmp(argv[arg_index], "-reduced") == 0 )
+      {
+         arg_index++;
+         reduced = atoi(argv[arg_index++]);
+      }
+      else if ( strcmp(argv[arg_index], "-ooc") == 0 )
+      {
+         arg_index++;
+         ooc = atoi(argv[arg_index++]);
+      }
+      else if ( strcmp(argv[arg_index], "-delta") == 0 )
+      {
+         arg_index++;
+         delta = atoi(argv[arg_index++]);
+      }
+      else if ( strcmp(argv[arg_index], "-threads") == 0 )
+      {
+         arg_index++;
+         threads = 1;
+      }
+      else if ( strcmp(argv[arg_index], "-cycle") == 0 )
+      {
+         arg_index++;
+         cycle = atoi(argv[arg_index++]);
+      }
+      else if ( strcmp(argv[arg_index], "-relax") == 0 )
+      {
+         arg_index++;
+         relax = argv[arg_index++];
+      }
       else if( strcmp(argv[arg_index], "-print_level") == 0 ){
          arg_index++;
          print_level = atoi(argv[arg_index++]);
@@ -607,6 +752,7 @@ int main (int argc, char *argv[])
    (app->xstop)         = xstop;
    (app->nspace)        = nspace;
    (app->print_level)   = print_level;
+   (app->threads)       = threads;
 
    /* Initialize storage for sc_info, for tracking space-time grids visited during the simulation */
    app->sc_info = (double*) malloc( 2*max_levels*sizeof(double) );
@@ -647,6 +793,8 @@ int main (int argc, char *argv[])
       braid_SetCFactor(core, -1, cfactor);
       braid_SetMaxIter(core, max_iter);
       braid_SetSeqSoln(core, use_sequential);
+      /* my_BufPack writes only doubles (the size is stored as a double) */
+      braid_SetPackedReals(core, 1);
       if (fmg)
       {
          braid_SetFMG(core);
@@ -655,6 +803,57 @@ int main (int argc, char *argv[])
       {
          braid_SetResidual(core, my_Residual);
       }
+      if (persistent)
+      {
+         braid_SetPersistentComm(core, 1);
+      }
+      if (bufview)
+      {
+         braid_SetBufView(core, my_BufView);
+      }
+      if (comm_agg)
+      {
+         braid_SetCommAggregate(core, 1);
+      }
+      if (compress)
+      {
+         braid_SetCompression(core, compress, compress_tol);
+      }
+      if (shm)
+      {
+         braid_SetShmComm(core, 1);
+      }
+      if (vpool > -1)
+      {
+         braid_SetCopy(core, my_Copy);
+         braid_SetVectorPool(core, vpool);
+      }
+      if (reduced > -1)
+      {
+         braid_SetReducedStorage(core, reduced);
+      }
+      if (ooc > -1)
+      {
+         braid_SetOutOfCore(core, "ex-02.ooc", ooc);
+      }
+      if (delta)
+      {
+         braid_SetDeltaStorage(core, delta, NULL, NULL);
+      }
+      if (threads)
+      {
+         /* my_Step, my_Sum, my_SpatialNorm, my_Residual and my_Clone (used with
+          * -view) are thread safe */
+         braid_SetThreadSafe(core, 1);
+      }
+      if (cycle > -1)
+      {
+         braid_SetCycle(core, cycle);
+      }
+      if (relax != NULL)
+      {
+         braid_SetRelaxSchedule(core, -1, relax);
+      }
       loglevels = log2(nspace - 1.0);
       if ( scoarsen && ( fabs(loglevels - round(loglevels)) > 1e-10 ))
       {
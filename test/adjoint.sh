@@ -101,7 +101,8 @@ TESTS=( "$RunString -np 4 $example_dir/ex-01-adjoint" \
         "$RunString -np 4 $example_dir/ex-04 -ntime 256 -mi 5 -gamma 1.0 -stepsize 100.0 -gtol 1e-4 -batol 10.0 -btol 100.0" \
         "$RunString -np 4 $example_dir/ex-04 -ntime 256 -mi 5 -gamma 1.0 -stepsize 100.0 -gtol 1e-4 -cf 8" \
         "$RunString -np 1 $example_dir/ex-04-serial" \
-        "$RunString -np 1 $example_dir/ex-04-serial -maxiter 5 -gtol 2e-3 -gamma 0.1 -stepsize 50.0" )
+        "$RunString -np 1 $example_dir/ex-04-serial -maxiter 5 -gtol 2e-3 -gamma 0.1 -stepsize 50.0" \
+        "$RunString -np 4 $example_dir/ex-01-adjoint -initzero" )
 
 # The below commands will then dump each of the tests to the output files 
 #   $output_dir/unfiltered.std.out.0, 
@@ -152,6 +153,14 @@ done
 # e.g., two different std.out.* files from identical runs with different
 # processor layouts could be identical ...
 
+# Creating the adjoint vectors with InitZero must not change the results of
+# ex-01-adjoint (Test 0), including the objective and gradient
+cd $output_dir
+diff -U3 -B std.out.0 std.out.12 >> std.err.12
+diff -U3 -B <(egrep "^ Objective|^ Gradient" unfiltered.std.out.0) \
+            <(egrep "^ Objective|^ Gradient" unfiltered.std.out.12) >> std.err.12
+cd $test_dir
+
 
 # Echo to stderr all nonempty error files in $output_dir.  test.sh
 # collects these file names and puts them in the error report
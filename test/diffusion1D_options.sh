@@ -0,0 +1,203 @@
+#!/bin/bash
+#BHEADER**********************************************************************
+#
+# Copyright (c) 2013, Lawrence Livermore National Security, LLC. 
+# Produced at the Lawrence Livermore National Laboratory. Written by 
+# Jacob Schroder, Rob Falgout, Tzanio Kolev, Ulrike Yang, Veselin 
+# Dobrev, et al. LLNL-CODE-660355. All rights reserved.
+# 
+# This file is part of XBraid. For support, post issues to the XBraid Github page.
+# 
+# This program is free software; you can redistribute it and/or modify it under
+# the terms of the GNU General Public License (as published by the Free Software
+# Foundation) version 2.1 dated February 1999.
+# 
+# This program is distributed in the hope that it will be useful, but WITHOUT ANY
+# WARRANTY; without even the IMPLIED WARRANTY OF MERCHANTABILITY or FITNESS FOR A
+# PARTICULAR PURPOSE. See the terms and conditions of the GNU General Public
+# License for more details.
+# 
+# You should have received a copy of the GNU Lesser General Public License along
+# with this program; if not, write to the Free Software Foundation, Inc., 59
+# Temple Place, Suite 330, Boston, MA 02111-1307 USA
+#
+#EHEADER**********************************************************************
+
+# scriptname holds the script name, with the .sh removed
+scriptname=`basename $0 .sh`
+
+# Echo usage information
+case $1 in
+   -h|-help)
+      cat <<EOF
+
+   $0 [-h|-help] 
+
+   where: -h|-help   prints this usage information and exits
+
+   This script runs tests of the Braid performance options (communication,
+   storage, threading and cycling) for a constant coefficient 1D heat
+   equation.  Options that do not change the arithmetic must reproduce the
+   residual history of the baseline run exactly, and the others must
+   reproduce their saved residual history.  A 2-level run also checks the
+   per-level user callback counts, with and without threads.  The output is
+   written to $scriptname.out, $scriptname.err and $scriptname.dir. This test
+   passes if $scriptname.err is empty.
+
+   Example usage: ./test.sh $0 
+
+EOF
+      exit
+      ;;
+esac
+
+# Determine csplit and mpirun command for this machine 
+OS=`uname`
+case $OS in
+   Linux*) 
+      MACHINES_FILE="hostname"
+      if [ ! -f $MACHINES_FILE ] ; then
+         hostname > $MACHINES_FILE
+      fi
+      RunString="mpirun -machinefile $MACHINES_FILE $*"
+      csplitcommand="csplit"
+      ;;
+   Darwin*)
+      csplitcommand="gcsplit"
+      RunString="mpirun --hostfile ~/.machinefile_mac"
+      ;;
+   *)
+      RunString="mpirun"
+      csplitcommand="csplit"
+      ;;
+esac
+
+
+
+# Setup
+example_dir="../examples"
+test_dir=`pwd`
+output_dir=`pwd`/$scriptname.dir
+rm -fr $output_dir
+mkdir -p $output_dir
+
+
+# compile the regression test drivers 
+echo "Compiling regression test drivers"
+cd $example_dir
+make clean
+make ex-02 
+cd $test_dir
+
+# Run the following regression tests.  Test 0 is the baseline. 
+base="$example_dir/ex-02 -ntime 256 -ml 4 -skip 0"
+TESTS=( "$RunString -np 4 $base" \
+        "$RunString -np 4 $base -persist" \
+        "$RunString -np 4 $base -view" \
+        "$RunString -np 4 $base -agg" \
+        "$RunString -np 4 $base -agg -persist" \
+        "$RunString -np 4 $base -compress 1 0.0" \
+        "$RunString -np 4 $base -compress 2 1.0e-3" \
+        "$RunString -np 4 $base -compress 2 1.0e-1" \
+        "$RunString -np 4 $base -shm" \
+        "$RunString -np 4 $base -vpool 4" \
+        "$RunString -np 4 $base -vpool 2 -view" \
+        "$RunString -np 4 $base -reduced 1" \
+        "$RunString -np 4 $base -reduced 0" \
+        "$RunString -np 4 $base -ooc 0" \
+        "$RunString -np 4 $base -ooc 4 -reduced 0" \
+        "$RunString -np 4 $base -delta 4" \
+        "$RunString -np 4 $base -delta 8 -reduced 1" \
+        "$RunString -np 4 $base -threads" \
+        "$RunString -np 4 $base -threads -res" \
+        "$RunString -np 4 $base -cycle 0" \
+        "$RunString -np 4 $base -cycle 2" \
+        "$RunString -np 4 $base -cycle 1" \
+        "$RunString -np 4 $base -relax FCF" \
+        "$RunString -np 4 $base -relax FCFCF" \
+        "$RunString -np 4 $base -relax FC0.7C1.2F" )
+
+# These tests must have the same residual history as Test 0
+SAME_AS_BASELINE=( 1 2 3 4 5 8 9 10 13 15 17 19 22 )
+
+# The below commands will then dump each of the tests to the output files 
+#   $output_dir/unfiltered.std.out.0, 
+#   $output_dir/std.out.0, 
+#   $output_dir/std.err.0,
+#    
+#   $output_dir/unfiltered.std.out.1,
+#   $output_dir/std.out.1, 
+#   $output_dir/std.err.1,
+#   ...
+#
+# The unfiltered output is the direct output of the script, whereas std.out.*
+# is filtered by a grep for the lines that are to be checked.  
+#
+lines_to_check="^  Braid: \|\| r_[0-9]* \|\| = [^,]*|^  time steps.*|^  number of levels.*|^  iterations.*"
+#
+# Then, each std.out.num is compared against stored correct output in 
+# $scriptname.saved.num, which is generated by splitting $scriptname.saved
+#
+TestDelimiter='# Begin Test'
+$csplitcommand -n 1 --silent --prefix $output_dir/$scriptname.saved. $scriptname.saved "%$TestDelimiter%" "/$TestDelimiter.*/" {*}
+#
+# The result of that diff is appended to std.err.num. 
+
+# Run regression tests
+counter=0
+for test in "${TESTS[@]}"
+do
+   echo "Running Test $counter"
+   eval "$test" 1>> $output_dir/unfiltered.std.out.$counter  2>> $output_dir/std.out.$counter
+   cd $output_dir
+   egrep -o "$lines_to_check" unfiltered.std.out.$counter > std.out.$counter
+   diff -U3 -B -bI"$TestDelimiter" $scriptname.saved.$counter std.out.$counter >> std.err.$counter
+   cd $test_dir
+   counter=$(( $counter + 1 ))
+done 
+
+# Per-level user callback counts of a 2-level run (see braid_PrintStats), which
+# must reproduce the saved counts and must not depend on threading
+CALL_TESTS=( "$RunString -np 2 $example_dir/ex-02 -ntime 64 -ml 2 -mi 3" \
+             "$RunString -np 2 $example_dir/ex-02 -ntime 64 -ml 2 -mi 3 -threads" )
+calls_to_check="^ +[01]( +[0-9]+){11}$"
+call_base=$counter
+for test in "${CALL_TESTS[@]}"
+do
+   echo "Running Test $counter"
+   eval "$test" 1>> $output_dir/unfiltered.std.out.$counter  2>> $output_dir/std.out.$counter
+   cd $output_dir
+   egrep "$calls_to_check" unfiltered.std.out.$counter > std.out.$counter
+   diff -U3 -B -bI"$TestDelimiter" $scriptname.saved.$counter std.out.$counter >> std.err.$counter
+   cd $test_dir
+   counter=$(( $counter + 1 ))
+done
+cd $output_dir
+diff -U3 -B std.out.$call_base std.out.$(( $call_base + 1 )) >> std.err.$(( $call_base + 1 ))
+cd $test_dir
+
+
+# Compare the options that do not change the arithmetic against the baseline
+cd $output_dir
+for counter in "${SAME_AS_BASELINE[@]}"
+do
+   diff -U3 -B std.out.0 std.out.$counter >> std.err.$counter
+done
+cd $test_dir
+
+
+# Echo to stderr all nonempty error files in $output_dir.  test.sh
+# collects these file names and puts them in the error report
+for errfile in $( find $output_dir ! -size 0 -name "*.err.*" )
+do
+   echo $errfile >&2
+done
+
+
+# remove machinefile, if created
+if [ -n $MACHINES_FILE ] ; then
+   rm $MACHINES_FILE 2> /dev/null
+fi
+
+rm braid.out.cycle 2> /dev/null
+rm ex-02*.out.* 2> /dev/null
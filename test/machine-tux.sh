@@ -56,6 +56,7 @@ mkdir -p $output_dir
 TESTS=( "diffusion1D.sh " \
         "diffusion1D_scaling.sh" \
         "diffusion1D_check_rnorm.sh" \
+        "diffusion1D_options.sh" \
         "diffusion2D.sh " \
         "diffusion2D_storage.sh " \
         "diffusion2D_scaling.sh " \